@@ -0,0 +1,54 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replacement global allocation functions that count every allocation made by
+ * the benchmarks.
+ */
+
+static std::atomic<std::size_t> allocations{0};
+static std::atomic<std::size_t> allocated_bytes{0};
+
+std::size_t bench::allocation_count() noexcept {
+	return allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t bench::allocated_bytes() noexcept {
+	return ::allocated_bytes.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size) {
+	return ::operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
@@ -0,0 +1,89 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/batch-parser.h"
+#include <memory>
+#include <thread>
+
+using Opt_Type = cpparse::Optional_Info::Type;
+
+namespace {
+
+	/** Number of command lines per batch */
+	constexpr std::size_t N_LINES{20000};
+
+	/**
+	 * Scheduler job command lines checked against one tool's parser, one in four
+	 * of which is rejected.
+	 */
+	struct Batch_Fixture {
+		cpparse::Argument_Parser parser;
+		std::vector<std::string> tokens;
+		std::vector<std::vector<const char *>> lines;
+
+		Batch_Fixture() {
+			parser.add_positional("script");
+			parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+			parser.add_optional("-q", "--queue");
+			parser.add_optional("-n", "--nodes");
+			parser.add_optional("-e", "--env", Opt_Type::APPEND);
+			for (int i = 0; i < 16; ++i)
+				parser.add_optional("--resource-" + std::to_string(i));
+
+			tokens.reserve(N_LINES);
+			for (std::size_t i = 0; i < N_LINES; ++i)
+				tokens.push_back("job-" + std::to_string(i) + ".sh");
+			for (std::size_t i = 0; i < N_LINES; ++i) {
+				lines.push_back({"submit", "-q", "batch", "--nodes", "4", "-e", "A=1", "-e", "B=2", "--resource-7", "gpu", tokens[i].c_str()});
+				if (i % 4 == 3)
+					lines.back().push_back("--bogus");
+			}
+		}
+	};
+
+	std::shared_ptr<Batch_Fixture> fixture() {
+		static const auto fixture = std::make_shared<Batch_Fixture>();
+		return fixture;
+	}
+
+	/**
+	 * @return the thread counts to measure: powers of two up to the hardware
+	 *         thread count, and the hardware thread count itself
+	 */
+	std::vector<unsigned> thread_counts() {
+		const auto n_hardware = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<unsigned> counts;
+		for (unsigned n = 1; n < n_hardware; n *= 2)
+			counts.push_back(n);
+		counts.push_back(n_hardware);
+		return counts;
+	}
+
+	const bool registered = [] {
+		for (const auto n_threads : thread_counts()) {
+			const auto suffix = "/threads-" + std::to_string(n_threads);
+			bench::register_benchmark("batch/validate" + suffix, [n_threads](std::size_t iterations) {
+				const auto lines = fixture();
+				const cpparse::Batch_Parser batch{lines->parser, n_threads};
+				for (std::size_t i = 0; i < iterations; ++i)
+					bench::do_not_optimize(batch.validate(lines->lines).failure_count());
+			}, N_LINES);
+			bench::register_benchmark("batch/parse" + suffix, [n_threads](std::size_t iterations) {
+				const auto lines = fixture();
+				const cpparse::Batch_Parser batch{lines->parser, n_threads};
+				for (std::size_t i = 0; i < iterations; ++i) {
+					const auto result = batch.parse(lines->lines, [](std::size_t, cpparse::Parse_Result &&values) {
+						bench::do_not_optimize(values);
+					});
+					bench::do_not_optimize(result.failure_count());
+				}
+			}, N_LINES);
+		}
+		return true;
+	}();
+
+}
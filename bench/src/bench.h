@@ -0,0 +1,96 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_BENCH_BENCH_H_
+#define CPARSEPARSE_BENCH_BENCH_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+	/** Benchmark body; runs the measured operation @a iterations times */
+	using Bench_Func = std::function<void(std::size_t iterations)>;
+
+	/**
+	 * Registered benchmark.
+	 */
+	struct Benchmark {
+		std::string name;
+		Bench_Func func;
+		std::size_t items_per_op;  // Items processed per iteration (e.g. tokens), or 0
+	};
+
+	/**
+	 * @return the list of registered benchmarks
+	 */
+	inline std::vector<Benchmark> &registry() {
+		static std::vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+	/**
+	 * Add a benchmark to the registry.
+	 *
+	 * Benchmarks are run once before being measured, so the body may lazily build
+	 * any fixtures it needs on the first call.
+	 *
+	 * @param name          benchmark name
+	 * @param func          benchmark body
+	 * @param items_per_op  items processed per iteration, used to report a per-item
+	 *                      time
+	 */
+	inline void register_benchmark(std::string name, Bench_Func func, std::size_t items_per_op = 0) {
+		registry().push_back(Benchmark{std::move(name), std::move(func), items_per_op});
+	}
+
+	/**
+	 * Static helper that adds a benchmark to the registry on construction.
+	 */
+	struct Registrar {
+		Registrar(std::string name, Bench_Func func) {
+			register_benchmark(std::move(name), std::move(func));
+		}
+	};
+
+	/**
+	 * @return the number of calls made to the global allocation functions so far
+	 */
+	std::size_t allocation_count() noexcept;
+
+	/**
+	 * @return the total number of bytes requested from the global allocation
+	 *         functions so far
+	 */
+	std::size_t allocated_bytes() noexcept;
+
+	/**
+	 * Prevent the compiler from optimizing away the computation of @a value.
+	 */
+	template<class T>
+	inline void do_not_optimize(const T &value) {
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+}
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+#define BENCH_UNIQUE(prefix) BENCH_CONCAT(prefix, __LINE__)
+
+/**
+ * Define and register a benchmark; the body runs the measured operation
+ * @a iterations times.
+ */
+#define BENCHMARK(name, iterations) \
+	static void BENCH_UNIQUE(bench_func_)(std::size_t iterations); \
+	static const bench::Registrar BENCH_UNIQUE(bench_registrar_){name, &BENCH_UNIQUE(bench_func_)}; \
+	static void BENCH_UNIQUE(bench_func_)(std::size_t iterations)
+
+#endif /* CPARSEPARSE_BENCH_BENCH_H_ */
@@ -0,0 +1,87 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/util/convert.h"
+#include <limits>
+#include <stdexcept>
+
+/** Numeric IDs as they would appear in a large append-style option list */
+static const char *const valid_ids[] = {"0", "17", "4096", "-25", "123456789", "9001", "42", "-7"};
+
+/** Values that fail numeric validation */
+static const char *const invalid_ids[] = {"abc", "", "x17", "--", "id-4096", "nan?", "-", "shard"};
+
+namespace stox_baseline {
+
+	/* Previous std::stoll/std::stold-based conversion, kept as the comparison baseline */
+
+	template<class T, class Convert_Func>
+	static bool parse_numeric_arg(const std::string &value, Convert_Func &&convert_func, T &out) {
+		try {
+			const auto n_value = convert_func(value);
+			if (n_value < std::numeric_limits<T>::lowest() || n_value > std::numeric_limits<T>::max())
+				throw std::out_of_range{""};
+			out = n_value;
+			return true;
+		} catch (const std::invalid_argument &ex) {
+			return false;
+		} catch (const std::out_of_range &ex) {
+			return false;
+		}
+	}
+
+	static bool parse_int(const std::string &value, int &out) {
+		return parse_numeric_arg<int>(value, [](const std::string &value) { return std::stoll(value); }, out);
+	}
+
+	static bool parse_double(const std::string &value, double &out) {
+		return parse_numeric_arg<double>(value, [](const std::string &value) { return std::stold(value); }, out);
+	}
+
+}
+
+template<class T, std::size_t N, class Convert_Func>
+static void run_conversions(std::size_t iterations, const char *const (&values)[N], Convert_Func &&convert) {
+	T out{};
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (auto value : values)
+			bench::do_not_optimize(convert(value, out));
+	}
+	bench::do_not_optimize(out);
+}
+
+BENCHMARK("convert/int/valid/stoll", iterations) {
+	run_conversions<int>(iterations, valid_ids, stox_baseline::parse_int);
+}
+
+BENCHMARK("convert/int/valid/convert_value", iterations) {
+	run_conversions<int>(iterations, valid_ids, [](const char *value, int &out) { return cpparse::convert_value<int>(value, out); });
+}
+
+BENCHMARK("convert/int/invalid/stoll", iterations) {
+	run_conversions<int>(iterations, invalid_ids, stox_baseline::parse_int);
+}
+
+BENCHMARK("convert/int/invalid/convert_value", iterations) {
+	run_conversions<int>(iterations, invalid_ids, [](const char *value, int &out) { return cpparse::convert_value<int>(value, out); });
+}
+
+BENCHMARK("convert/double/valid/stold", iterations) {
+	run_conversions<double>(iterations, valid_ids, stox_baseline::parse_double);
+}
+
+BENCHMARK("convert/double/valid/convert_value", iterations) {
+	run_conversions<double>(iterations, valid_ids, [](const char *value, double &out) { return cpparse::convert_value<double>(value, out); });
+}
+
+BENCHMARK("convert/double/invalid/stold", iterations) {
+	run_conversions<double>(iterations, invalid_ids, stox_baseline::parse_double);
+}
+
+BENCHMARK("convert/double/invalid/convert_value", iterations) {
+	run_conversions<double>(iterations, invalid_ids, [](const char *value, double &out) { return cpparse::convert_value<double>(value, out); });
+}
@@ -0,0 +1,194 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/argument-parser.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using Opt_Type = cpparse::Optional_Info::Type;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Benchmark measurement.
+ */
+struct Measurement {
+	std::size_t iterations;
+	double ns_per_op;
+	double allocs_per_op;
+	double bytes_per_op;
+};
+
+/**
+ * Report output format.
+ */
+enum class Format { TEXT, CSV, JSON };
+
+/**
+ * Run the benchmark with an increasing iteration count until it takes at least
+ * @a min_time seconds.
+ */
+static Measurement run_benchmark(const bench::Benchmark &benchmark, double min_time) {
+	benchmark.func(1);
+	for (std::size_t iterations = 1;; iterations *= 2) {
+		const auto allocs_start = bench::allocation_count();
+		const auto bytes_start = bench::allocated_bytes();
+		const auto tstart = Clock::now();
+		benchmark.func(iterations);
+		const std::chrono::duration<double> elapsed = Clock::now() - tstart;
+		const auto allocs = bench::allocation_count() - allocs_start;
+		const auto bytes = bench::allocated_bytes() - bytes_start;
+		if (elapsed.count() >= min_time || iterations >= (std::size_t{1} << 40)) {
+			return Measurement{iterations, elapsed.count() * 1e9 / iterations, static_cast<double>(allocs) / iterations,
+					static_cast<double>(bytes) / iterations};
+		}
+	}
+}
+
+/**
+ * Check whether the benchmark name contains any of the filter strings.
+ */
+static bool selected(const std::string &name, const std::vector<std::string> &filters) {
+	if (filters.empty())
+		return true;
+	for (const auto &filter : filters) {
+		if (name.find(filter) != std::string::npos)
+			return true;
+	}
+	return false;
+}
+
+/**
+ * Parse the report format name.
+ *
+ * @throw std::runtime_error  If the name is not a supported format.
+ */
+static Format parse_format(const std::string &name) {
+	if (name == "text")
+		return Format::TEXT;
+	if (name == "csv")
+		return Format::CSV;
+	if (name == "json")
+		return Format::JSON;
+	throw std::runtime_error{"invalid format '" + name + "', must be one of: 'text', 'csv', 'json'"};
+}
+
+/**
+ * Write the string as a quoted JSON string.
+ */
+static void write_json_string(std::ostream &out, const std::string &str) {
+	out << '"';
+	for (auto c : str) {
+		if (c == '"' || c == '\\')
+			out << '\\';
+		out << c;
+	}
+	out << '"';
+}
+
+/**
+ * Write the report header, before any results.
+ */
+static void write_header(std::ostream &out, Format format, double min_time) {
+	switch (format) {
+	case Format::TEXT:
+		break;
+	case Format::CSV:
+		out << "name,iterations,ns_per_op,allocs_per_op,bytes_per_op,ns_per_item,items_per_sec\n";
+		break;
+	case Format::JSON:
+		out << "{\n  \"context\": {\"cplusplus\": " << __cplusplus << ", \"min_time\": " << min_time << "},\n  \"benchmarks\": [";
+		break;
+	}
+}
+
+/**
+ * Write the result of a single benchmark.
+ */
+static void write_result(std::ostream &out, Format format, const bench::Benchmark &benchmark, const Measurement &result, bool first) {
+	const auto ns_per_item = benchmark.items_per_op ? result.ns_per_op / benchmark.items_per_op : 0.0;
+	const auto items_per_sec = ns_per_item > 0 ? 1e9 / ns_per_item : 0.0;
+	switch (format) {
+	case Format::TEXT:
+		out << std::left << std::setw(48) << benchmark.name
+			<< std::right << std::setw(10) << result.iterations
+			<< std::fixed << std::setprecision(1)
+			<< std::setw(16) << result.ns_per_op << " ns/op"
+			<< std::setw(12) << result.allocs_per_op << " allocs/op"
+			<< std::setw(12) << result.bytes_per_op << " B/op";
+		if (benchmark.items_per_op)
+			out << std::setw(10) << ns_per_item << " ns/item" << std::setprecision(0) << std::setw(14) << items_per_sec << " items/s";
+		out << std::endl;
+		break;
+	case Format::CSV:
+		out << benchmark.name << ',' << result.iterations << std::fixed << std::setprecision(3)
+			<< ',' << result.ns_per_op << ',' << result.allocs_per_op << ',' << result.bytes_per_op << ',';
+		if (benchmark.items_per_op)
+			out << ns_per_item << ',' << items_per_sec;
+		else
+			out << ',';
+		out << std::endl;
+		break;
+	case Format::JSON:
+		out << (first ? "\n" : ",\n") << "    {\"name\": ";
+		write_json_string(out, benchmark.name);
+		out << ", \"iterations\": " << result.iterations << std::fixed << std::setprecision(3)
+			<< ", \"ns_per_op\": " << result.ns_per_op
+			<< ", \"allocs_per_op\": " << result.allocs_per_op
+			<< ", \"bytes_per_op\": " << result.bytes_per_op;
+		if (benchmark.items_per_op)
+			out << ", \"ns_per_item\": " << ns_per_item << ", \"items_per_sec\": " << items_per_sec;
+		out << "}" << std::flush;
+		break;
+	}
+}
+
+/**
+ * Write the report footer, after all results.
+ */
+static void write_footer(std::ostream &out, Format format) {
+	if (format == Format::JSON)
+		out << "\n  ]\n}" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	cpparse::Argument_Parser parser;
+	parser.set_description("Run the CParseParse micro-benchmarks");
+	auto &filter = parser.add_optional("-f", "--filter", Opt_Type::APPEND).help("only run benchmarks whose name contains FILTER");
+	auto &min_time = parser.add_optional("-t", "--min-time", Opt_Type::SINGLE).help("minimum seconds to run each benchmark [default: 0.2]");
+	auto &list = parser.add_optional("-l", "--list", Opt_Type::FLAG).help("list benchmark names and exit");
+	auto &format = parser.add_optional("-F", "--format", Opt_Type::SINGLE).help("report format: 'text', 'csv' or 'json' [default: text]");
+	try {
+		parser.parse_args(argc, argv);
+		const auto filters = filter.as_type_all<std::string>();
+		const auto min_seconds = min_time.as_type<double>(0.2);
+		const auto report_format = parse_format(format.as_type<std::string>("text"));
+
+		if (list.as_type<bool>()) {
+			for (const auto &benchmark : bench::registry()) {
+				if (selected(benchmark.name, filters))
+					std::cout << benchmark.name << std::endl;
+			}
+			return 0;
+		}
+
+		bool first{true};
+		write_header(std::cout, report_format, min_seconds);
+		for (const auto &benchmark : bench::registry()) {
+			if (!selected(benchmark.name, filters))
+				continue;
+			write_result(std::cout, report_format, benchmark, run_benchmark(benchmark, min_seconds), first);
+			first = false;
+		}
+		write_footer(std::cout, report_format);
+		return 0;
+	} catch (const std::runtime_error &ex) {
+		std::cerr << ex.what() << std::endl;
+		parser.print_usage();
+		return 1;
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/util/option-trie.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+	/**
+	 * Option names resembling those of a large tool, indexed both by the trie and
+	 * by the hash map previously used to resolve them.
+	 */
+	struct Lookup_Fixture {
+		std::vector<std::string> names;
+		std::vector<std::string> prefixes;  // Shortest unambiguous prefix of each name
+		cpparse::Option_Trie trie;
+		std::unordered_map<cpparse::String_View, std::size_t, cpparse::String_View_Hash> map;
+
+		explicit Lookup_Fixture(std::size_t n_options) {
+			static const char *const words[] = {"log", "output", "input", "cache", "thread", "verbose", "config", "retry"};
+			for (std::size_t i = 0; i < n_options; ++i)
+				names.push_back(std::string{words[i % 8]} + "-level-" + std::to_string(i));
+			for (std::size_t i = 0; i < n_options; ++i) {
+				trie.insert(names[i], i);
+				map.emplace(names[i], i);
+			}
+			for (const auto &name : names) {
+				auto length = name.size();
+				while (length > 1 && trie.find_prefix(cpparse::String_View{name.data(), length - 1}) != cpparse::Option_Trie::AMBIGUOUS)
+					--length;
+				prefixes.push_back(name.substr(0, length));
+			}
+		}
+	};
+
+	std::shared_ptr<Lookup_Fixture> fixture(std::size_t n_options) {
+		static std::shared_ptr<Lookup_Fixture> fixtures[3];
+		auto &fixture = fixtures[n_options == 10 ? 0 : n_options == 100 ? 1 : 2];
+		if (!fixture)
+			fixture = std::make_shared<Lookup_Fixture>(n_options);
+		return fixture;
+	}
+
+	/* Tokens are looked up by their C string, as they arrive in argv */
+
+	const bool registered = [] {
+		for (const std::size_t n_options : {10, 100, 1000}) {
+			const auto suffix = "/options-" + std::to_string(n_options);
+			bench::register_benchmark("option-lookup/unordered-map" + suffix, [n_options](std::size_t iterations) {
+				const auto lookup = fixture(n_options);
+				const auto &map = lookup->map;
+				for (std::size_t i = 0; i < iterations; ++i) {
+					for (const auto &name : lookup->names) {
+						const auto it = map.find(name.c_str());
+						bench::do_not_optimize(it == map.end() ? std::size_t{0} : it->second);
+					}
+				}
+			}, n_options);
+			bench::register_benchmark("option-lookup/trie" + suffix, [n_options](std::size_t iterations) {
+				const auto lookup = fixture(n_options);
+				for (std::size_t i = 0; i < iterations; ++i) {
+					for (const auto &name : lookup->names) {
+						const auto token = name.c_str();
+						bench::do_not_optimize(lookup->trie.find(cpparse::String_View{token, std::strlen(token)}));
+					}
+				}
+			}, n_options);
+			bench::register_benchmark("option-lookup/trie-prefix" + suffix, [n_options](std::size_t iterations) {
+				const auto lookup = fixture(n_options);
+				for (std::size_t i = 0; i < iterations; ++i) {
+					for (const auto &prefix : lookup->prefixes) {
+						const auto token = prefix.c_str();
+						bench::do_not_optimize(lookup->trie.find_prefix(cpparse::String_View{token, std::strlen(token)}));
+					}
+				}
+			}, n_options);
+		}
+		return true;
+	}();
+
+}
@@ -0,0 +1,130 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/util/option-names.h"
+#include <regex>
+#include <string>
+#include <vector>
+
+/**
+ * Tokens representative of a command line: flags, long options, values and
+ * positional arguments.
+ */
+static const char *const sample_tokens[] = {
+	"-v", "--log-level", "42", "input-file.txt", "--output", "out/dir", "-j", "8", "--show-time", "-"
+};
+
+namespace regex_baseline {
+
+	/* Previous std::regex-based implementations, kept as the comparison baseline */
+
+	static bool valid_option_name(const std::string &name) {
+		std::cmatch m;
+		std::regex_match(name.c_str(), m, std::regex("-([a-zA-Z_]|-?[a-zA-Z_][a-zA-Z0-9_-]+)"));
+		return !m.empty();
+	}
+
+	static std::string format_option_name(const std::string &name) {
+		std::cmatch m;
+		std::regex_match(name.c_str(), m, std::regex("--?([a-zA-Z_][a-zA-Z0-9_-]+)"));
+		return m.size() < 2 ? "" : m[1].str();
+	}
+
+	static char format_flag_name(const std::string &name) {
+		std::cmatch m;
+		std::regex_match(name.c_str(), m, std::regex("-([a-zA-Z_])"));
+		return m.size() < 2 ? 0 : m[1].str()[0];
+	}
+
+}
+
+BENCHMARK("option-names/classify-token/regex", iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (auto token : sample_tokens) {
+			bench::do_not_optimize(regex_baseline::format_flag_name(token));
+			bench::do_not_optimize(regex_baseline::format_option_name(token));
+			bench::do_not_optimize(regex_baseline::valid_option_name(token));
+		}
+	}
+}
+
+BENCHMARK("option-names/classify-token/precompiled-regex", iterations) {
+	static const std::regex option_re{"-([a-zA-Z_]|-?[a-zA-Z_][a-zA-Z0-9_-]+)"};
+	static const std::regex long_re{"--?([a-zA-Z_][a-zA-Z0-9_-]+)"};
+	static const std::regex flag_re{"-([a-zA-Z_])"};
+	std::cmatch m;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (auto token : sample_tokens) {
+			bench::do_not_optimize(std::regex_match(token, m, flag_re));
+			bench::do_not_optimize(std::regex_match(token, m, long_re));
+			bench::do_not_optimize(std::regex_match(token, m, option_re));
+		}
+	}
+}
+
+BENCHMARK("option-names/classify-token/matcher", iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (auto token : sample_tokens) {
+			bench::do_not_optimize(cpparse::flag_option_name(token));
+			bench::do_not_optimize(cpparse::long_option_name(token));
+			bench::do_not_optimize(cpparse::valid_option_name(token));
+		}
+	}
+}
+
+namespace {
+
+	/** Number of tokens per scanning pass */
+	constexpr std::size_t N_SCAN_TOKENS{4096};
+
+	/**
+	 * Long option names and values of a generated command line, of assorted
+	 * lengths so that every block offset is exercised.
+	 */
+	const std::vector<std::string> &scan_tokens() {
+		static const auto tokens = [] {
+			std::vector<std::string> tokens;
+			tokens.reserve(N_SCAN_TOKENS);
+			for (std::size_t i = 0; i < N_SCAN_TOKENS; ++i) {
+				if (i % 2)
+					tokens.push_back("value-" + std::string(i % 40, 'x') + "=" + std::to_string(i));
+				else
+					tokens.push_back("--option-name-" + std::string(i % 24, 'y') + "_" + std::to_string(i));
+			}
+			return tokens;
+		}();
+		return tokens;
+	}
+
+	template<class Scan>
+	bench::Bench_Func scan_benchmark(Scan scan) {
+		return [scan](std::size_t iterations) {
+			const auto &tokens = scan_tokens();
+			for (std::size_t i = 0; i < iterations; ++i) {
+				for (const auto &token : tokens)
+					bench::do_not_optimize(scan(token.c_str()));
+			}
+		};
+	}
+
+	const bool registered = [] {
+		const std::string instruction_set{cpparse::name_scan_instruction_set()};
+		bench::register_benchmark("option-names/scan/" + instruction_set, scan_benchmark([](const char *token) {
+			return cpparse::scan_name_chars(token);
+		}), N_SCAN_TOKENS);
+		if (instruction_set != "scalar") {
+			bench::register_benchmark("option-names/scan/scalar", scan_benchmark([](const char *token) {
+				return cpparse::scan_name_chars_scalar(token);
+			}), N_SCAN_TOKENS);
+		}
+		bench::register_benchmark("option-names/long-option-name/" + instruction_set, scan_benchmark([](const char *token) {
+			return cpparse::long_option_name(token);
+		}), N_SCAN_TOKENS);
+		return true;
+	}();
+
+}
@@ -0,0 +1,259 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/argument-parser.h"
+#include <memory>
+
+using Opt_Type = cpparse::Optional_Info::Type;
+
+namespace {
+
+	/**
+	 * Parser and command line with @a n_tokens user arguments, dominated by
+	 * append-style options.
+	 */
+	struct Parse_Fixture {
+		cpparse::Argument_Parser parser;
+		std::vector<std::string> tokens;
+		std::vector<const char *> argv;
+
+		explicit Parse_Fixture(std::size_t n_tokens) {
+			parser.add_positional("output");
+			parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+			parser.add_optional("-t", "--threads", Opt_Type::SINGLE);
+			parser.add_optional("-i", "--input", Opt_Type::APPEND);
+			parser.add_optional("-x", "--exclude", Opt_Type::APPEND);
+
+			tokens = {"out-dir", "-v", "--threads", "8"};
+			for (std::size_t i = 0; tokens.size() + 2 <= n_tokens; ++i) {
+				tokens.push_back(i % 2 ? "--input" : "-x");
+				tokens.push_back("shard-" + std::to_string(i) + ".dat");
+			}
+			tokens.resize(n_tokens, "extra");
+
+			argv.push_back("bench-program");
+			for (const auto &token : tokens)
+				argv.push_back(token.c_str());
+		}
+
+		void parse() {
+			auto args = argv;
+			int argc = args.size();
+			auto p_argv = args.data();
+			parser.parse_args(argc, p_argv);
+		}
+	};
+
+	/**
+	 * Register parse_args() benchmarks over a range of argv sizes.
+	 */
+	const bool registered = [] {
+		for (std::size_t n_tokens : {10, 100, 1000, 10000, 100000, 1000000}) {
+			auto fixture = std::make_shared<std::unique_ptr<Parse_Fixture>>();
+			bench::register_benchmark("parse-args/append-heavy/" + std::to_string(n_tokens), [fixture, n_tokens](std::size_t iterations) {
+				if (!*fixture)
+					fixture->reset(new Parse_Fixture{n_tokens});
+				for (std::size_t i = 0; i < iterations; ++i)
+					(*fixture)->parse();
+			}, n_tokens);
+		}
+		return true;
+	}();
+
+}
+
+/**
+ * Define, parse and tear down a small parser, with its storage allocated from
+ * @a resource.
+ */
+static void build_and_parse(cpparse::Memory_Resource *resource) {
+	static const char *const args[] = {"bench-program", "out-dir", "-v", "--threads", "8", "-i", "a.dat", "-i", "b.dat"};
+	cpparse::Argument_Parser parser{cpparse::Argument_Parser::Options{}.memory_resource(resource)};
+	parser.add_positional("output");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-t", "--threads", Opt_Type::SINGLE);
+	parser.add_optional("-i", "--input", Opt_Type::APPEND);
+	for (int i = 0; i < 16; ++i)
+		parser.add_optional("--option-" + std::to_string(i), Opt_Type::SINGLE);
+
+	std::vector<const char *> argv(std::begin(args), std::end(args));
+	int argc = argv.size();
+	auto p_argv = argv.data();
+	parser.parse_args(argc, p_argv);
+	bench::do_not_optimize(parser.arg_count("input"));
+}
+
+BENCHMARK("parse-args/lifecycle/default-resource", iterations) {
+	for (std::size_t i = 0; i < iterations; ++i)
+		build_and_parse(cpparse::default_resource());
+}
+
+BENCHMARK("parse-args/lifecycle/monotonic-arena", iterations) {
+	alignas(std::max_align_t) static char buffer[64 * 1024];
+	for (std::size_t i = 0; i < iterations; ++i) {
+		cpparse::Monotonic_Buffer_Resource arena{buffer, sizeof(buffer)};
+		build_and_parse(&arena);
+	}
+}
+
+static constexpr auto definition_schema = cpparse::make_static_schema(
+	cpparse::static_positional("output"),
+	cpparse::static_optional("-v", "--verbose", Opt_Type::FLAG),
+	cpparse::static_optional("-t", "--threads", Opt_Type::SINGLE),
+	cpparse::static_optional("-i", "--input", Opt_Type::APPEND),
+	cpparse::static_optional("-x", "--exclude", Opt_Type::APPEND),
+	cpparse::static_optional("--log-level"),
+	cpparse::static_optional("--log-file"),
+	cpparse::static_optional("--config"),
+	cpparse::static_optional("-q", "--quiet", Opt_Type::FLAG)
+);
+
+BENCHMARK("parse-args/definition/runtime", iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		cpparse::Argument_Parser parser;
+		parser.add_positional("output");
+		parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+		parser.add_optional("-t", "--threads", Opt_Type::SINGLE);
+		parser.add_optional("-i", "--input", Opt_Type::APPEND);
+		parser.add_optional("-x", "--exclude", Opt_Type::APPEND);
+		parser.add_optional("--log-level");
+		parser.add_optional("--log-file");
+		parser.add_optional("--config");
+		parser.add_optional("-q", "--quiet", Opt_Type::FLAG);
+		bench::do_not_optimize(parser);
+	}
+}
+
+BENCHMARK("parse-args/definition/static-schema", iterations) {
+	for (std::size_t i = 0; i < iterations; ++i) {
+		cpparse::Argument_Parser parser{definition_schema};
+		bench::do_not_optimize(parser);
+	}
+}
+
+namespace {
+
+	/** Number of attached values on the command lines of the format benchmarks */
+	constexpr std::size_t N_ATTACHED{1000};
+
+	/**
+	 * Command line passing each value attached to its option (@a --input=a.dat),
+	 * and the same command line with every value in its own token.
+	 */
+	struct Format_Fixture {
+		std::vector<std::string> attached{"-vq"};
+		std::vector<std::string> separate{"-v", "-q"};
+
+		Format_Fixture() {
+			for (std::size_t i = 0; i < N_ATTACHED; ++i) {
+				const auto value = "shard-" + std::to_string(i) + ".dat";
+				attached.push_back("--input=" + value);
+				separate.push_back("--input");
+				separate.push_back(value);
+			}
+		}
+
+		static std::vector<const char *> args(const std::vector<std::string> &tokens) {
+			std::vector<const char *> argv{"bench-program"};
+			for (const auto &token : tokens)
+				argv.push_back(token.c_str());
+			return argv;
+		}
+	};
+
+	const Format_Fixture &format_fixture() {
+		static const Format_Fixture fixture;
+		return fixture;
+	}
+
+	void define_format_arguments(cpparse::Argument_Parser &parser) {
+		parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+		parser.add_optional("-q", "--quiet", Opt_Type::FLAG);
+		parser.add_optional("-i", "--input", Opt_Type::APPEND);
+	}
+
+	void parse_tokens(cpparse::Argument_Parser &parser, std::vector<const char *> argv) {
+		int argc = argv.size();
+		auto p_argv = argv.data();
+		parser.parse_args(argc, p_argv);
+	}
+
+	/**
+	 * Expand attached values and bundled flags into separate tokens, as a wrapper
+	 * had to before the parser accepted them.
+	 */
+	std::vector<std::string> expand_tokens(const std::vector<std::string> &tokens) {
+		std::vector<std::string> expanded;
+		for (const auto &token : tokens) {
+			const auto equals = token.find('=');
+			if (token.compare(0, 2, "--") == 0 && equals != std::string::npos) {
+				expanded.push_back(token.substr(0, equals));
+				expanded.push_back(token.substr(equals + 1));
+			} else if (token.size() > 2 && token[0] == '-' && token[1] != '-') {
+				for (std::size_t i = 1; i < token.size(); ++i)
+					expanded.push_back(std::string{'-', token[i]});
+			} else {
+				expanded.push_back(token);
+			}
+		}
+		return expanded;
+	}
+
+}
+
+BENCHMARK("parse-args/formats/separate-tokens", iterations) {
+	const auto argv = Format_Fixture::args(format_fixture().separate);
+	cpparse::Argument_Parser parser;
+	define_format_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parse_tokens(parser, argv);
+		bench::do_not_optimize(parser.arg_count("input"));
+	}
+}
+
+BENCHMARK("parse-args/formats/attached-in-place", iterations) {
+	const auto argv = Format_Fixture::args(format_fixture().attached);
+	cpparse::Argument_Parser parser{cpparse::Argument_Parser::Options{}.inline_values(true).bundled_flags(true)};
+	define_format_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parse_tokens(parser, argv);
+		bench::do_not_optimize(parser.arg_count("input"));
+	}
+}
+
+BENCHMARK("parse-args/formats/attached-pre-expanded", iterations) {
+	const auto &attached = format_fixture().attached;
+	cpparse::Argument_Parser parser;
+	define_format_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		const auto expanded = expand_tokens(attached);
+		parse_tokens(parser, Format_Fixture::args(expanded));
+		bench::do_not_optimize(parser.arg_count("input"));
+	}
+}
+
+BENCHMARK("parse-args/storage/views", iterations) {
+	const auto argv = Format_Fixture::args(format_fixture().separate);
+	cpparse::Argument_Parser parser;
+	define_format_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parse_tokens(parser, argv);
+		bench::do_not_optimize(parser.memory_footprint());
+	}
+}
+
+BENCHMARK("parse-args/storage/compact", iterations) {
+	const auto argv = Format_Fixture::args(format_fixture().separate);
+	cpparse::Argument_Parser parser;
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-q", "--quiet", Opt_Type::FLAG);
+	parser.add_optional("-i", "--input", Opt_Type::APPEND).compact_storage(true);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parse_tokens(parser, argv);
+		bench::do_not_optimize(parser.memory_footprint());
+	}
+}
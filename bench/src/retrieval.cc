@@ -0,0 +1,196 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/argument-parser.h"
+
+using Opt_Type = cpparse::Optional_Info::Type;
+
+/**
+ * Parse a command line with a single numeric option for the retrieval benchmarks.
+ */
+static cpparse::Optional_Info &parse_batch_size(cpparse::Argument_Parser &parser) {
+	auto &batch_size = parser.add_optional("-b", "--batch-size", Opt_Type::SINGLE);
+	std::vector<const char *> args{"bench-program", "--batch-size", "4096"};
+	int argc = args.size();
+	auto argv = args.data();
+	parser.parse_args(argc, argv);
+	return batch_size;
+}
+
+BENCHMARK("retrieval/arg<int>/uncached", iterations) {
+	cpparse::Argument_Parser parser;
+	parse_batch_size(parser);
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(parser.arg<int>("batch-size"));
+}
+
+BENCHMARK("retrieval/arg<int>/cached", iterations) {
+	cpparse::Argument_Parser parser;
+	parse_batch_size(parser);
+	parser.cache_arg<int>("batch-size");
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(parser.arg<int>("batch-size"));
+}
+
+BENCHMARK("retrieval/as_type<int>/uncached", iterations) {
+	cpparse::Argument_Parser parser;
+	auto &batch_size = parse_batch_size(parser);
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(batch_size.as_type<int>());
+}
+
+BENCHMARK("retrieval/as_type<int>/cached", iterations) {
+	cpparse::Argument_Parser parser;
+	auto &batch_size = parse_batch_size(parser).cache<int>();
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(batch_size.as_type<int>());
+}
+
+namespace {
+
+	/**
+	 * Parser holding an append-style option with 100k numeric shard IDs.
+	 */
+	struct Shard_Fixture {
+		static constexpr std::size_t n_ids{100000};
+
+		cpparse::Argument_Parser parser;
+		cpparse::Optional_Info &shard_ids;
+		std::vector<std::string> tokens;
+
+		Shard_Fixture()
+				: shard_ids(parser.add_optional("--shard-id", Opt_Type::APPEND)) {
+			for (std::size_t i = 0; i < n_ids; ++i)
+				tokens.push_back(std::to_string(i * 7919));
+			std::vector<const char *> args{"bench-program"};
+			for (const auto &token : tokens) {
+				args.push_back("--shard-id");
+				args.push_back(token.c_str());
+			}
+			int argc = args.size();
+			auto argv = args.data();
+			parser.parse_args(argc, argv);
+		}
+	};
+
+	Shard_Fixture &shard_fixture() {
+		static Shard_Fixture fixture;
+		return fixture;
+	}
+
+}
+
+BENCHMARK("retrieval/100k-ids/as_type_all", iterations) {
+	auto &fixture = shard_fixture();
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(fixture.shard_ids.as_type_all<int>().back());
+}
+
+BENCHMARK("retrieval/100k-ids/as_type_into", iterations) {
+	auto &fixture = shard_fixture();
+	std::vector<int> ids(Shard_Fixture::n_ids);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		bench::do_not_optimize(fixture.shard_ids.as_type_into<int>(ids.data(), ids.size()).count);
+		bench::do_not_optimize(ids.back());
+	}
+}
+
+namespace {
+
+	/**
+	 * Settings of a service read from a dozen options after each parse.
+	 */
+	struct Service_Config {
+		std::string host;
+		int port{0};
+		int workers{0};
+		int backlog{0};
+		double timeout{0};
+		double retry_delay{0};
+		unsigned max_connections{0};
+		unsigned buffer_size{0};
+		bool verbose{false};
+		bool daemon{false};
+		std::string log_file;
+		std::vector<int> shards;
+	};
+
+	const char *const service_args[] = {
+		"bench-program", "--host", "localhost", "--port", "8080", "--workers", "16", "--backlog", "128", "--timeout", "2.5",
+		"--retry-delay", "0.25", "--max-connections", "1024", "--buffer-size", "65536", "--verbose", "--daemon",
+		"--log-file", "/var/log/service.log", "--shard", "1", "--shard", "2", "--shard", "3"
+	};
+
+	/**
+	 * @param bind  whether to bind the options to the members of a Service_Config
+	 */
+	void add_service_options(cpparse::Argument_Parser &parser, bool bind) {
+		auto &host = parser.add_optional("--host");
+		auto &port = parser.add_optional("--port");
+		auto &workers = parser.add_optional("--workers");
+		auto &backlog = parser.add_optional("--backlog");
+		auto &timeout = parser.add_optional("--timeout");
+		auto &retry_delay = parser.add_optional("--retry-delay");
+		auto &max_connections = parser.add_optional("--max-connections");
+		auto &buffer_size = parser.add_optional("--buffer-size");
+		auto &verbose = parser.add_optional("--verbose", Opt_Type::FLAG);
+		auto &daemon = parser.add_optional("--daemon", Opt_Type::FLAG);
+		auto &log_file = parser.add_optional("--log-file");
+		auto &shards = parser.add_optional("--shard", Opt_Type::APPEND);
+		if (bind) {
+			host.bind(&Service_Config::host);
+			port.bind(&Service_Config::port);
+			workers.bind(&Service_Config::workers);
+			backlog.bind(&Service_Config::backlog);
+			timeout.bind(&Service_Config::timeout);
+			retry_delay.bind(&Service_Config::retry_delay);
+			max_connections.bind(&Service_Config::max_connections);
+			buffer_size.bind(&Service_Config::buffer_size);
+			verbose.bind(&Service_Config::verbose);
+			daemon.bind(&Service_Config::daemon);
+			log_file.bind(&Service_Config::log_file);
+			shards.bind(&Service_Config::shards);
+		}
+	}
+
+}
+
+BENCHMARK("retrieval/service-config/parse-then-arg", iterations) {
+	cpparse::Argument_Parser parser;
+	add_service_options(parser, false);
+	Service_Config config;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		int argc = sizeof(service_args) / sizeof(service_args[0]);
+		auto argv = const_cast<const char **>(service_args);
+		parser.parse_args(argc, argv);
+		config.host = parser.arg<std::string>("host");
+		config.port = parser.arg<int>("port");
+		config.workers = parser.arg<int>("workers");
+		config.backlog = parser.arg<int>("backlog");
+		config.timeout = parser.arg<double>("timeout");
+		config.retry_delay = parser.arg<double>("retry-delay");
+		config.max_connections = parser.arg<unsigned>("max-connections");
+		config.buffer_size = parser.arg<unsigned>("buffer-size");
+		config.verbose = parser.arg<bool>("verbose");
+		config.daemon = parser.arg<bool>("daemon");
+		config.log_file = parser.arg<std::string>("log-file");
+		config.shards = parser.args<int>("shard");
+		bench::do_not_optimize(config);
+	}
+}
+
+BENCHMARK("retrieval/service-config/parse-bound", iterations) {
+	cpparse::Argument_Parser parser;
+	add_service_options(parser, true);
+	Service_Config config;
+	for (std::size_t i = 0; i < iterations; ++i) {
+		int argc = sizeof(service_args) / sizeof(service_args[0]);
+		auto argv = const_cast<const char **>(service_args);
+		parser.parse_args(argc, argv, config);
+		bench::do_not_optimize(config);
+	}
+}
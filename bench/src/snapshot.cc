@@ -0,0 +1,115 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/argument-parser.h"
+#include <cstdio>
+#include <memory>
+
+using Opt_Type = cpparse::Optional_Info::Type;
+
+namespace {
+
+	/** Number of values on the supervisor's command line */
+	constexpr std::size_t N_VALUES{10000};
+
+	void define_worker_arguments(cpparse::Argument_Parser &parser) {
+		parser.add_positional("job");
+		parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+		parser.add_optional("--queue");
+		parser.add_optional("--input", Opt_Type::APPEND);
+	}
+
+	/**
+	 * Command line of a supervisor passing a long list of inputs to its workers,
+	 * and the snapshot of its parse.
+	 */
+	struct Snapshot_Fixture {
+		std::vector<std::string> tokens;
+		std::vector<const char *> args{"supervisor", "-v", "--queue", "batch", "job-7"};
+		std::string blob;
+		std::string path{"bench-snapshot.bin"};
+
+		Snapshot_Fixture() {
+			for (std::size_t i = 0; i < N_VALUES; ++i)
+				tokens.push_back("/data/shard-" + std::to_string(i) + ".bin");
+			for (const auto &token : tokens) {
+				args.push_back("--input");
+				args.push_back(token.c_str());
+			}
+			cpparse::Argument_Parser parser;
+			define_worker_arguments(parser);
+			int argc = args.size();
+			auto argv = args.data();
+			parser.parse_args(argc, argv);
+			blob = parser.snapshot();
+			parser.save_snapshot(path);
+		}
+
+		~Snapshot_Fixture() {
+			std::remove(path.c_str());
+		}
+	};
+
+	std::shared_ptr<Snapshot_Fixture> fixture() {
+		static const auto fixture = std::make_shared<Snapshot_Fixture>();
+		return fixture;
+	}
+
+}
+
+BENCHMARK("snapshot/worker-start/parse-args", iterations) {
+	const auto snapshot = fixture();
+	cpparse::Argument_Parser parser;
+	define_worker_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		auto args = snapshot->args;
+		int argc = args.size();
+		auto argv = args.data();
+		parser.parse_args(argc, argv);
+		bench::do_not_optimize(parser.arg<cpparse::String_View>("job"));
+	}
+}
+
+BENCHMARK("snapshot/worker-start/load-memory", iterations) {
+	const auto snapshot = fixture();
+	cpparse::Argument_Parser parser;
+	define_worker_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parser.load_snapshot(snapshot->blob.data(), snapshot->blob.size());
+		bench::do_not_optimize(parser.arg<cpparse::String_View>("job"));
+	}
+}
+
+BENCHMARK("snapshot/worker-start/load-file", iterations) {
+	const auto snapshot = fixture();
+	cpparse::Argument_Parser parser;
+	define_worker_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parser.load_snapshot(snapshot->path);
+		bench::do_not_optimize(parser.arg<cpparse::String_View>("job"));
+	}
+}
+
+BENCHMARK("snapshot/save", iterations) {
+	const auto snapshot = fixture();
+	cpparse::Argument_Parser parser;
+	define_worker_arguments(parser);
+	parser.load_snapshot(snapshot->blob.data(), snapshot->blob.size());
+	for (std::size_t i = 0; i < iterations; ++i)
+		bench::do_not_optimize(parser.snapshot().size());
+}
+
+BENCHMARK("snapshot/seal", iterations) {
+	const auto snapshot = fixture();
+	cpparse::Argument_Parser parser;
+	define_worker_arguments(parser);
+	for (std::size_t i = 0; i < iterations; ++i) {
+		parser.load_snapshot(snapshot->blob.data(), snapshot->blob.size());
+		parser.seal();
+		bench::do_not_optimize(parser.arg<cpparse::String_View>("job"));
+	}
+}
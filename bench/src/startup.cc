@@ -0,0 +1,299 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "bench.h"
+#include "cparseparse/argument-parser.h"
+#include <memory>
+#include <streambuf>
+
+using Opt_Type = cpparse::Optional_Info::Type;
+
+namespace {
+
+	/**
+	 * Stream buffer that discards its output, so that rendering is measured without
+	 * the cost of I/O.
+	 */
+	class Null_Buffer : public std::streambuf {
+	protected:
+		int_type overflow(int_type c) override {
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char *, std::streamsize n) override {
+			return n;
+		}
+	};
+
+	/**
+	 * Names and help text for a definition of @a n_options options, generated
+	 * up front so that only the parser's own work is measured.
+	 */
+	struct Definition {
+		std::vector<std::string> flags;
+		std::vector<std::string> long_names;
+		std::vector<std::string> help_texts;
+
+		explicit Definition(std::size_t n_options) {
+			static const std::string flag_chars{"abcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+			for (std::size_t i = 0; i < n_options; ++i) {
+				flags.push_back(i < flag_chars.size() ? std::string{"-"} + flag_chars[i] : "");
+				long_names.push_back("--option-" + std::to_string(i));
+				help_texts.push_back("help text describing option number " + std::to_string(i));
+			}
+		}
+
+		/**
+		 * Add the options to the parser, cycling through the option types.
+		 */
+		void define(cpparse::Argument_Parser &parser) const {
+			static const Opt_Type types[] = {Opt_Type::FLAG, Opt_Type::SINGLE, Opt_Type::APPEND};
+			for (std::size_t i = 0; i < long_names.size(); ++i) {
+				const auto type = types[i % 3];
+				auto &optional = flags[i].empty() ? parser.add_optional(long_names[i], type) : parser.add_optional(flags[i], long_names[i], type);
+				optional.help(help_texts[i]);
+			}
+		}
+	};
+
+	/**
+	 * Parser and command line of a particular shape, parsed repeatedly.
+	 */
+	struct Parse_Fixture {
+		cpparse::Argument_Parser parser;
+		std::vector<std::string> tokens;
+		std::vector<const char *> argv;  // Reused so that only the parse allocates
+
+		void fill_argv() {
+			argv.assign(1, "bench-program");
+			for (const auto &token : tokens)
+				argv.push_back(token.c_str());
+		}
+
+		void parse() {
+			fill_argv();
+			int argc = argv.size();
+			auto p_argv = argv.data();
+			parser.parse_args(argc, p_argv);
+		}
+
+		/**
+		 * Parse the command line, which is expected to be rejected.
+		 */
+		void parse_error() {
+			try {
+				parse();
+			} catch (const std::runtime_error &ex) {
+				bench::do_not_optimize(ex);
+			}
+		}
+
+		/**
+		 * Check the command line without throwing, as for rejecting untrusted input.
+		 */
+		void validate() {
+			fill_argv();
+			const auto status = parser.validate(argv.size(), argv.data());
+			bench::do_not_optimize(status);
+		}
+	};
+
+	/**
+	 * Command line of 20 flags.
+	 */
+	Parse_Fixture flags_fixture() {
+		Parse_Fixture fixture;
+		for (char c = 'a'; c <= 'u'; ++c) {
+			if (c == 'h')
+				continue;
+			fixture.parser.add_optional(std::string{"-"} + c, std::string{"--flag-"} + c, Opt_Type::FLAG);
+			fixture.tokens.push_back(std::string{"-"} + c);
+		}
+		return fixture;
+	}
+
+	/**
+	 * Command line of 20 single-value options.
+	 */
+	Parse_Fixture single_fixture() {
+		Parse_Fixture fixture;
+		for (int i = 0; i < 20; ++i) {
+			fixture.parser.add_optional("--single-" + std::to_string(i), Opt_Type::SINGLE);
+			fixture.tokens.push_back("--single-" + std::to_string(i));
+			fixture.tokens.push_back("value-" + std::to_string(i));
+		}
+		return fixture;
+	}
+
+	/**
+	 * Command line of a single append-style option given @a n_values times.
+	 */
+	Parse_Fixture append_fixture(std::size_t n_values) {
+		Parse_Fixture fixture;
+		fixture.parser.add_optional("-i", "--id", Opt_Type::APPEND);
+		for (std::size_t i = 0; i < n_values; ++i) {
+			fixture.tokens.push_back("-i");
+			fixture.tokens.push_back(std::to_string(i));
+		}
+		return fixture;
+	}
+
+	/**
+	 * Command line whose last token is @a bad_token, after a few valid options.
+	 */
+	Parse_Fixture error_fixture(const std::string &bad_token) {
+		Parse_Fixture fixture;
+		fixture.parser.add_positional("input");
+		fixture.parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+		fixture.parser.add_optional("-o", "--output", Opt_Type::SINGLE);
+		fixture.tokens = {"in.txt", "-v", "-o", "out.txt", bad_token};
+		return fixture;
+	}
+
+	/**
+	 * Register a benchmark that repeatedly parses the fixture's command line,
+	 * building the fixture on the first run.
+	 */
+	template<class Make_Fixture>
+	void register_parse(const std::string &name, Make_Fixture make_fixture, bool expect_error = false) {
+		auto fixture = std::make_shared<std::unique_ptr<Parse_Fixture>>();
+		bench::register_benchmark(name, [fixture, make_fixture, expect_error](std::size_t iterations) {
+			if (!*fixture)
+				fixture->reset(new Parse_Fixture{make_fixture()});
+			for (std::size_t i = 0; i < iterations; ++i) {
+				if (expect_error)
+					(*fixture)->parse_error();
+				else
+					(*fixture)->parse();
+			}
+		});
+	}
+
+	/**
+	 * Register a benchmark that repeatedly validates the fixture's command line,
+	 * building the fixture on the first run.
+	 */
+	template<class Make_Fixture>
+	void register_validate(const std::string &name, Make_Fixture make_fixture) {
+		auto fixture = std::make_shared<std::unique_ptr<Parse_Fixture>>();
+		bench::register_benchmark(name, [fixture, make_fixture](std::size_t iterations) {
+			if (!*fixture)
+				fixture->reset(new Parse_Fixture{make_fixture()});
+			for (std::size_t i = 0; i < iterations; ++i)
+				(*fixture)->validate();
+		});
+	}
+
+	/** Number of subcommands in the subcommand benchmarks, each with its own options */
+	constexpr std::size_t N_SUBCOMMANDS{40};
+
+	/**
+	 * Define the options of one subcommand.
+	 */
+	void define_subcommand(cpparse::Argument_Parser &parser, const Definition &definition) {
+		parser.add_positional("target");
+		definition.define(parser);
+	}
+
+	const bool registered = [] {
+		for (std::size_t n_options : {10, 100, 1000}) {
+			auto definition = std::make_shared<Definition>(n_options);
+			bench::register_benchmark("startup/define/" + std::to_string(n_options), [definition](std::size_t iterations) {
+				for (std::size_t i = 0; i < iterations; ++i) {
+					cpparse::Argument_Parser parser;
+					definition->define(parser);
+					bench::do_not_optimize(parser);
+				}
+			}, n_options);
+		}
+
+		register_parse("startup/parse/flags", flags_fixture);
+		register_parse("startup/parse/single", single_fixture);
+		register_parse("startup/parse/append/10000", [] { return append_fixture(10000); });
+		register_parse("startup/parse/error/unknown-option", [] { return error_fixture("--bogus"); }, true);
+		register_parse("startup/parse/error/unknown-flag", [] { return error_fixture("-z"); }, true);
+		register_parse("startup/parse/error/missing-value", [] { return error_fixture("--output"); }, true);
+		register_validate("startup/validate/error/unknown-option", [] { return error_fixture("--bogus"); });
+		register_validate("startup/validate/error/unknown-flag", [] { return error_fixture("-z"); });
+		register_validate("startup/validate/error/missing-value", [] { return error_fixture("--output"); });
+		register_validate("startup/validate/single", single_fixture);
+
+		auto sub_definition = std::make_shared<Definition>(20);
+		bench::register_benchmark("startup/subcommands/eager", [sub_definition](std::size_t iterations) {
+			static const char *const args[] = {"bench-program", "cmd-17", "target", "--option-1", "value"};
+			for (std::size_t i = 0; i < iterations; ++i) {
+				std::vector<std::unique_ptr<cpparse::Argument_Parser>> parsers;
+				for (std::size_t j = 0; j < N_SUBCOMMANDS; ++j) {
+					parsers.emplace_back(new cpparse::Argument_Parser);
+					define_subcommand(*parsers.back(), *sub_definition);
+				}
+				int argc = 4;
+				auto argv = const_cast<const char **>(args + 1);
+				parsers[17]->parse_args(argc, argv);
+				bench::do_not_optimize(parsers);
+			}
+		});
+		bench::register_benchmark("startup/subcommands/lazy", [sub_definition](std::size_t iterations) {
+			static const char *const args[] = {"bench-program", "cmd-17", "target", "--option-1", "value"};
+			std::vector<const char *> argv_copy;
+			for (std::size_t i = 0; i < iterations; ++i) {
+				cpparse::Argument_Parser parser;
+				for (std::size_t j = 0; j < N_SUBCOMMANDS; ++j) {
+					parser.add_subcommand("cmd-" + std::to_string(j), [sub_definition](cpparse::Argument_Parser &sub) {
+						define_subcommand(sub, *sub_definition);
+					});
+				}
+				argv_copy.assign(std::begin(args), std::end(args));
+				int argc = argv_copy.size();
+				auto argv = argv_copy.data();
+				parser.parse_args(argc, argv);
+				bench::do_not_optimize(parser);
+			}
+		});
+
+		auto server = std::make_shared<cpparse::Argument_Parser>();
+		for (std::size_t j = 0; j < N_SUBCOMMANDS; ++j) {
+			server->add_subcommand("cmd-" + std::to_string(j), [sub_definition](cpparse::Argument_Parser &sub) {
+				define_subcommand(sub, *sub_definition);
+			});
+		}
+		bench::register_benchmark("startup/reparse/alternating-subcommands", [server](std::size_t iterations) {
+			static const char *const commands[][5] = {
+				{"server", "cmd-3", "target", "--option-1", "value"},
+				{"server", "cmd-17", "target", "-a", "-d"},
+			};
+			const char *argv_copy[5];
+			for (std::size_t i = 0; i < iterations; ++i) {
+				const auto &command = commands[i % 2];
+				std::copy(std::begin(command), std::end(command), argv_copy);
+				int argc = 5;
+				auto argv = static_cast<const char **>(argv_copy);
+				server->reset();
+				server->parse_args(argc, argv);
+			}
+		});
+
+		for (std::size_t n_options : {10, 100}) {
+			auto parser = std::make_shared<cpparse::Argument_Parser>();
+			Definition{n_options}.define(*parser);
+			parser->add_positional("input").help("input file");
+			bench::register_benchmark("startup/print-help/" + std::to_string(n_options), [parser](std::size_t iterations) {
+				Null_Buffer buffer;
+				std::ostream out{&buffer};
+				for (std::size_t i = 0; i < iterations; ++i)
+					parser->print_help(out);
+			}, n_options);
+			bench::register_benchmark("startup/print-usage/" + std::to_string(n_options), [parser](std::size_t iterations) {
+				Null_Buffer buffer;
+				std::ostream out{&buffer};
+				for (std::size_t i = 0; i < iterations; ++i)
+					parser->print_usage(out);
+			});
+		}
+		return true;
+	}();
+
+}
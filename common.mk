@@ -7,6 +7,8 @@
 # Build options
 BUILD := release
 STD := c++11
+INSTRUMENTATION := 0
+LIBRARY := 0
 
 CC := g++
 CPPFLAGS := -I../include
@@ -20,6 +22,20 @@ else
 $(error BUILD must be either 'debug' or 'release')
 endif
 
+ifeq ($(INSTRUMENTATION),1)
+CPPFLAGS += -DCPARSEPARSE_INSTRUMENTATION
+else ifneq ($(INSTRUMENTATION),0)
+$(error INSTRUMENTATION must be either 0 or 1)
+endif
+
+# Link against the compiled library instead of using the header-only build
+ifeq ($(LIBRARY),1)
+CPPFLAGS += -DCPARSEPARSE_LIBRARY
+LDLIBS := ../lib/libcparseparse.a
+else ifneq ($(LIBRARY),0)
+$(error LIBRARY must be either 0 or 1)
+endif
+
 ifeq ($(CDIR),)
 $(error CDIR must be defined)
 endif
@@ -7,15 +7,225 @@
 #ifndef CPARSEPARSE_ARGUMENT_INFO_H_
 #define CPARSEPARSE_ARGUMENT_INFO_H_
 
+#include "cparseparse/util/convert.h"
 #include "cparseparse/util/errstr.h"
 #include "cparseparse/util/string-ops.h"
-#include <iomanip>
+#include "cparseparse/util/string-view.h"
+#include "cparseparse/util/value-cache.h"
+#include "cparseparse/util/value-list.h"
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace cpparse {
 
+	/**
+	 * Format the error message reported when an argument cannot be parsed as type
+	 * T.
+	 *
+	 * @tparam T           type the argument was parsed as
+	 * @param script_name  script name prefixed to the message
+	 * @param name         argument name
+	 * @param status       conversion status
+	 * @return the error message
+	 */
+	template<class T>
+	typename std::enable_if<std::is_same<T, bool>::value, std::string>::type conversion_error(const std::string &script_name,
+			const std::string &name, Convert_Status) {
+		return script_errstr(script_name, "'", name, "' must be one of: 'true', 'false', 'yes', 'no', 'on', 'off'");
+	}
+	template<class T>
+	typename std::enable_if<std::is_same<T, char>::value, std::string>::type conversion_error(const std::string &script_name,
+			const std::string &name, Convert_Status) {
+		return script_errstr(script_name, "'", name, "' must be a single character");
+	}
+	template<class T>
+	typename std::enable_if<!std::is_same<T, bool>::value && !std::is_same<T, char>::value && std::is_arithmetic<T>::value, std::string>::type
+	conversion_error(const std::string &script_name, const std::string &name, Convert_Status status) {
+		if (status == Convert_Status::OUT_OF_RANGE)
+			return script_errstr(script_name, "'", name, "' must be in range [", std::numeric_limits<T>::min(), ",", std::numeric_limits<T>::max(), "]");
+		return script_errstr(script_name, "'", name, "' must be of integral type");
+	}
+	template<class T>
+	typename std::enable_if<!std::is_arithmetic<T>::value, std::string>::type conversion_error(const std::string &script_name,
+			const std::string &name, Convert_Status) {
+		return script_errstr(script_name, "'", name, "' has an invalid value");
+	}
+
+	/**
+	 * Whether convert_value() supports values of type @a T.
+	 */
+	template<class T>
+	struct _Has_Builtin_Conversion : std::integral_constant<bool, std::is_arithmetic<T>::value
+			|| std::is_same<T, std::string>::value || std::is_same<T, String_View>::value> { };
+
+	/**
+	 * Converters registered for an argument with Argument_Info::converter(), keyed
+	 * by the type they convert to.
+	 *
+	 * A registered converter takes precedence over convert_value(), so it can also
+	 * replace the conversion of a built-in type for a single argument.
+	 */
+	class Converter_Registry {
+	public:
+
+		/**
+		 * @return true if no converters are registered, or false otherwise
+		 */
+		bool empty() const noexcept {
+			return m_entries.empty();
+		}
+
+		/**
+		 * Register the converter for type @a T, replacing any registered before.
+		 *
+		 * @tparam T            converted value type
+		 * @tparam Convert_Func callable type, invoked as @a convert(value, out)
+		 * @param convert       callable converting a String_View into a @a T and
+		 *                      returning the Convert_Status
+		 */
+		template<class T, class Convert_Func>
+		void add(Convert_Func &&convert) {
+			typename std::decay<Convert_Func>::type fn(std::forward<Convert_Func>(convert));
+			Entry entry{type_key<T>(), [fn](String_View value, void *out) mutable -> Convert_Status {
+				return fn(value, *static_cast<T *>(out));
+			}, &store_values<T>};
+			for (auto &existing : m_entries) {
+				if (existing.key == entry.key) {
+					existing = std::move(entry);
+					return;
+				}
+			}
+			m_entries.push_back(std::move(entry));
+		}
+
+		/**
+		 * Convert the value as type @a T with the registered converter, or with
+		 * convert_value() if none is registered for type @a T.
+		 *
+		 * @tparam T     converted value type
+		 * @param value  value to convert
+		 * @param out    converted value
+		 * @param name   argument name, used in the error message
+		 * @return the conversion status
+		 * @throw std::logic_error  if type @a T has neither a registered converter
+		 *                          nor a built-in conversion
+		 */
+		template<class T>
+		Convert_Status convert(String_View value, T &out, const std::string &name) const {
+			for (const auto &entry : m_entries) {
+				if (entry.key == type_key<T>())
+					return entry.convert(value, &out);
+			}
+			return convert_builtin(value, out, name);
+		}
+
+		/**
+		 * Convert the values with every registered converter and store the results
+		 * in the cache.
+		 *
+		 * @param cache        cache to store the converted values in
+		 * @param values       values to convert
+		 * @param script_name  script name prefixed to conversion errors
+		 * @param name         argument name
+		 * @throw std::runtime_error  if any value cannot be converted
+		 */
+		void store_all(Value_Cache &cache, const Value_Range &values, const std::string &script_name, const std::string &name) const {
+			for (const auto &entry : m_entries)
+				entry.store(entry, cache, values, script_name, name);
+		}
+
+	private:
+
+		struct Entry {
+			const void *key;
+			std::function<Convert_Status(String_View, void *)> convert;  // Writes into the T pointed to
+			void (*store)(const Entry &, Value_Cache &, const Value_Range &, const std::string &, const std::string &);
+		};
+
+		std::vector<Entry> m_entries;
+
+		template<class T>
+		static void store_values(const Entry &entry, Value_Cache &cache, const Value_Range &values, const std::string &script_name,
+				const std::string &name) {
+			cache.store<T>(values.size(), [&](std::size_t idx) {
+				T value{};
+				const auto status = entry.convert(values[idx], &value);
+				if (status != Convert_Status::OK)
+					throw std::runtime_error{conversion_error<T>(script_name, name, status)};
+				return value;
+			});
+		}
+
+		template<class T>
+		static typename std::enable_if<_Has_Builtin_Conversion<T>::value, Convert_Status>::type convert_builtin(String_View value, T &out,
+				const std::string &) {
+			return convert_value<T>(value, out);
+		}
+
+		template<class T>
+		static typename std::enable_if<!_Has_Builtin_Conversion<T>::value, Convert_Status>::type convert_builtin(String_View, T &,
+				const std::string &name) {
+			throw std::logic_error{lerrstr("no converter registered for the requested type of '", name, "'")};
+		}
+
+	};
+
+	/**
+	 * Writer of an argument's values into a variable bound with
+	 * Argument_Info::bind(), which receives the last value.
+	 */
+	template<class T>
+	struct _Bound_Value {
+		static void write(T &target, const Value_Range &values, const Converter_Registry &converters, const std::string &script_name,
+				const std::string &name) {
+			T value{};
+			const auto status = converters.convert<T>(values.back(), value, name);
+			if (status != Convert_Status::OK)
+				throw std::runtime_error{conversion_error<T>(script_name, name, status)};
+			target = std::move(value);
+		}
+	};
+
+	/**
+	 * Writer of an argument's values into a bound vector, which receives every
+	 * value and keeps its capacity between parses.
+	 */
+	template<class T, class Allocator>
+	struct _Bound_Value<std::vector<T, Allocator>> {
+		static void write(std::vector<T, Allocator> &target, const Value_Range &values, const Converter_Registry &converters,
+				const std::string &script_name, const std::string &name) {
+			target.resize(values.size());
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				T value{};
+				const auto status = converters.convert<T>(values[i], value, name);
+				if (status != Convert_Status::OK)
+					throw std::runtime_error{conversion_error<T>(script_name, name, status)};
+				target[i] = std::move(value);
+			}
+		}
+	};
+
+	/**
+	 * Rendered usage and help text.
+	 *
+	 * Shared between a parser and its argument info objects, so that changing any
+	 * part of the definition invalidates the rendered text.
+	 */
+	struct Help_Cache {
+		std::string script_name;  // Script name the text was rendered with
+		std::string usage;
+		std::string help;
+		bool valid{false};
+
+		void invalidate() noexcept {
+			valid = false;
+		}
+	};
+
 	/**
 	 * Argument info object storing information about a generic argument.
 	 */
@@ -67,92 +277,181 @@ namespace cpparse {
 		template<class String>
 		Argument_Type &help(String &&help_text) noexcept(std::is_nothrow_assignable<std::string, String &&>::value) {
 			m_help_text = std::forward<String>(help_text);
+			if (m_help_cache)
+				m_help_cache->invalidate();
 			return reinterpret_cast<Argument_Type &>(*this);
 		}
 
-	protected:
+		/**
+		 * Bind a variable to this argument, into which Argument_Parser::parse_args()
+		 * writes the value converted as type @a T.
+		 *
+		 * Binding a @a std::vector writes every value of an append-type argument;
+		 * binding any other type writes the last value given. A variable is left
+		 * unchanged when its argument is not given, so its initial value acts as the
+		 * default. Values are not written by Argument_Parser::parse().
+		 *
+		 * @tparam T     type of the variable, which must outlive the parser
+		 * @param target variable to write to
+		 * @return a reference to this object
+		 */
+		template<class T>
+		Argument_Type &bind(T &target) {
+			const auto &converters = m_converters;
+			m_binding = [&target, &converters](void *, const Value_Range &values, const std::string &script_name, const std::string &name) {
+				_Bound_Value<T>::write(target, values, converters, script_name, name);
+			};
+			m_bind_type = nullptr;
+			return reinterpret_cast<Argument_Type &>(*this);
+		}
 
-		std::string m_name;
-		std::string m_help_text;
+		/**
+		 * Bind a data member to this argument, into which
+		 * Argument_Parser::parse_args(argc, argv, target) writes the value converted
+		 * as type @a T.
+		 *
+		 * Written as for bind(T &), into the member of the object passed to
+		 * parse_args().
+		 *
+		 * @tparam Struct  type of the object passed to parse_args()
+		 * @tparam T       type of the member
+		 * @param member   pointer to the member to write to
+		 * @return a reference to this object
+		 */
+		template<class Struct, class T>
+		Argument_Type &bind(T Struct::*member) {
+			const auto &converters = m_converters;
+			m_binding = [member, &converters](void *object, const Value_Range &values, const std::string &script_name, const std::string &name) {
+				_Bound_Value<T>::write(static_cast<Struct *>(object)->*member, values, converters, script_name, name);
+			};
+			m_bind_type = type_key<Struct>();
+			return reinterpret_cast<Argument_Type &>(*this);
+		}
+
+		/**
+		 * @return the converters registered with converter()
+		 */
+		const Converter_Registry &converters() const noexcept {
+			return m_converters;
+		}
 
 		/**
-		 * Print the argument name and help text.
+		 * Register a converter that parses this argument's values as type @a T.
 		 *
-		 * @param text_width  text width spacing
-		 * @param out         output stream
+		 * Values can then be retrieved as type @a T like those of the built-in types,
+		 * and registering a converter for a built-in type replaces its conversion for
+		 * this argument. Argument_Parser::parse_args() runs every registered converter
+		 * once, right after matching, and caches the results as cache() does, so that
+		 * retrieving them afterwards does not parse them again.
+		 *
+		 * @tparam T             converted value type, which must be
+		 *                       default-constructible
+		 * @tparam Convert_Func  callable type, invoked as @a convert(value, out) with
+		 *                       a String_View and a @a T reference
+		 * @param convert        callable converting the value and returning the
+		 *                       Convert_Status
+		 * @return a reference to this object
 		 */
-		void print_help(std::size_t text_width, std::ostream &out = std::cout) const {
-			print_help(m_name, text_width, out);
+		template<class T, class Convert_Func>
+		Argument_Type &converter(Convert_Func &&convert) {
+			m_converters.add<T>(std::forward<Convert_Func>(convert));
+			m_cache.invalidate();
+			return reinterpret_cast<Argument_Type &>(*this);
 		}
 
 		/**
-		 * Print the argument name and help text.
+		 * Add a validator that checks each value of this argument after it is
+		 * matched, e.g. that a path exists or that a hostname resolves.
+		 *
+		 * Argument_Parser::parse_args() runs the validators of every value given,
+		 * after any converters, on up to Options::validation_threads() threads at
+		 * once, so validators must be safe to call concurrently with each other.
+		 * Values rejected by any validator are reported together by a single
+		 * Validation_Error. Validators are not run by Argument_Parser::parse(), and
+		 * cannot be added to an argument with a value callback (see
+		 * Optional_Info::on_value()), whose values are never stored to be checked.
 		 *
-		 * @param name        argument name
+		 * @tparam Validator_Func  callable type, invoked as @a validate(value) with a
+		 *                         String_View
+		 * @param validate         callable returning an empty string if the value is
+		 *                         valid, or else the reason it is not
+		 * @return a reference to this object
+		 */
+		template<class Validator_Func>
+		Argument_Type &validator(Validator_Func &&validate) {
+			m_validators.emplace_back(std::forward<Validator_Func>(validate));
+			return reinterpret_cast<Argument_Type &>(*this);
+		}
+
+	protected:
+
+		/**
+		 * Check of a single value, returning the reason it is invalid or an empty
+		 * string.
+		 */
+		using Validator = std::function<std::string(String_View)>;
+
+		/**
+		 * Writer of the argument's values into the bound variable or member, invoked
+		 * as @a binding(object, values, script_name, name).
+		 */
+		using Binding = std::function<void(void *, const Value_Range &, const std::string &, const std::string &)>;
+
+		std::string m_name;
+		std::string m_help_text;
+		Value_Cache m_cache;
+		Converter_Registry m_converters;  // Set by converter()
+		std::vector<Validator> m_validators;  // Set by validator()
+		Help_Cache *m_help_cache{nullptr};  // Invalidated when the help text changes
+		const std::string *m_script_name{nullptr};  // Script name of the owning parser's last parse
+		Binding m_binding;  // Set by bind()
+		const void *m_bind_type{nullptr};  // Key of the struct whose member is bound, or nullptr for a variable
+
+		/**
+		 * Complete a help line by padding the name column and appending the help text.
+		 *
+		 * @param line_start  position in @a out at which the line starts
 		 * @param text_width  text width spacing
-		 * @param out         output stream
+		 * @param out         string holding the line
 		 */
-		void print_help(const std::string &name, std::size_t text_width, std::ostream &out = std::cout) const {
-			out << "  " << std::left << std::setw(text_width - 2) << name << m_help_text << std::endl;
+		void render_help_text(std::size_t line_start, std::size_t text_width, std::string &out) const {
+			const auto column = out.size() - line_start;
+			if (column < text_width)
+				out.append(text_width - column, ' ');
+			out += m_help_text;
+			out += '\n';
 		}
 
 		/**
 		 * Parse the argument as type T.
 		 *
-		 * Valid choices for T are booleans, unsigned/signed integer types, floating point types, and std::string.
+		 * Valid choices for T are booleans, unsigned/signed integer types, floating point types, std::string,
+		 * String_View and any type with a converter registered with converter(). Parsing as String_View
+		 * returns the stored view without copying.
 		 *
 		 * @tparam T     type to parse the argument as
 		 * @param value  the argument value as a string
 		 * @return the argument parsed as type T
+		 * @throw std::runtime_error  if the argument cannot be parsed as type T
+		 * @throw std::logic_error    if no conversion exists for type T
 		 */
 		template<class T>
-		typename std::enable_if<std::is_same<T, bool>::value, T>::type parse_as_type(const std::string &value) const {
-			if (value == "true" || value == "yes" || value == "on")
-				return true;
-			else if (value == "false" || value == "no" || value == "off")
-				return false;
-			throw std::runtime_error{errstr("'", m_name, "' must be one of: 'true', 'false', 'yes', 'no', 'on', 'off'")};
+		T parse_as_type(String_View value) const {
+			T result{};
+			const auto status = m_converters.convert<T>(value, result, m_name);
+			if (status != Convert_Status::OK)
+				throw std::runtime_error{conversion_error<T>(status)};
+			return result;
 		}
-		template<class T>
-		typename std::enable_if<std::is_same<T, char>::value, T>::type parse_as_type(const std::string &value) const {
-			if (value.size() != 1)
-				throw std::runtime_error{errstr("'", m_name, "' must be a single character")};
-			return value[0];
-		}
-		template<class T>
-		typename std::enable_if<!std::is_same<T, bool>::value && std::is_integral<T>::value && std::is_unsigned<T>::value, T>::type parse_as_type(const std::string &value) const {
-			return parse_numeric_arg<T>(value, [](const std::string &value) { return cpparse::stoull(value); });
-		}
-		template<class T>
-		typename std::enable_if<!std::is_same<T, char>::value && std::is_integral<T>::value && std::is_signed<T>::value, T>::type parse_as_type(const std::string &value) const {
-			return parse_numeric_arg<T>(value, [](const std::string &value) { return std::stoll(value); });
-		}
-		template<class T>
-		typename std::enable_if<std::is_floating_point<T>::value, T>::type parse_as_type(const std::string &value) const {
-			return parse_numeric_arg<T>(value, [](const std::string &value) { return std::stold(value); });
-		}
-		template<class T>
-		typename std::enable_if<std::is_same<T, std::string>::value, T>::type parse_as_type(std::string value) const noexcept {
-			return value;
-		}
-
-	private:
 
 		/**
-		 * Parse the string argument as a numeric of type T.
+		 * Format the error message reported when the argument cannot be parsed as
+		 * type T.
 		 */
-		template<class T, class Convert_Func>
-		T parse_numeric_arg(const std::string &value, Convert_Func &&convert_func) const {
-			try {
-				const auto n_value = convert_func(value);
-				if (n_value < std::numeric_limits<T>::lowest() || n_value > std::numeric_limits<T>::max())
-					throw std::out_of_range{""};
-				return n_value;
-			} catch (const std::invalid_argument &ex) {
-				throw std::runtime_error{errstr("'", m_name, "' must be of integral type")};
-			} catch (const std::out_of_range &ex) {
-				throw std::runtime_error{errstr("'", m_name, "' must be in range [", std::numeric_limits<T>::min(), ",", std::numeric_limits<T>::max(), "]")};
-			}
+		template<class T>
+		std::string conversion_error(Convert_Status status) const {
+			static const std::string no_script_name;
+			return cpparse::conversion_error<T>(m_script_name ? *m_script_name : no_script_name, m_name, status);
 		}
 
 	};
@@ -7,12 +7,30 @@
 #ifndef CPARSEPARSE_ARGUMENT_PARSER
 #define CPARSEPARSE_ARGUMENT_PARSER
 
+#include "cparseparse/instrumentation.h"
 #include "cparseparse/optional-info.h"
+#include "cparseparse/parse-result.h"
+#include "cparseparse/parse-status.h"
 #include "cparseparse/positional-info.h"
+#include "cparseparse/static-schema.h"
+#include "cparseparse/subcommand-info.h"
+#include "cparseparse/token-source.h"
+#include "cparseparse/validation-error.h"
 #include "cparseparse/util/compat.h"
-#include <regex>
+#include "cparseparse/util/mapped-file.h"
+#include "cparseparse/util/memory-resource.h"
+#include "cparseparse/util/option-names.h"
+#include "cparseparse/util/option-trie.h"
+#include "cparseparse/util/shared-region.h"
+#include "cparseparse/util/snapshot.h"
+#include "cparseparse/util/string-ops.h"
+#include "cparseparse/util/string-view.h"
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace cpparse {
 
@@ -23,6 +41,10 @@ namespace cpparse {
 	 * 1. Add argument definitions using add_positional() and add_optional().
 	 * 2. Pass the user-supplied command-line arguments to parse_args().
 	 * 3. Retrieve each argument by name using arg() and arg_at().
+	 *
+	 * Alternatively, parse() matches the arguments without modifying the parser
+	 * and returns the values in a Parse_Result. A fully defined parser can then be
+	 * shared between threads that each parse their own argument vectors.
 	 */
 	class Argument_Parser {
 	public:
@@ -33,13 +55,115 @@ namespace cpparse {
 		class Options {
 			friend class Argument_Parser;
 			bool m_auto_help{true};  // Automatically add a '-h/--help' flag
+			bool m_zero_copy{false};  // Store parsed values as views into argv
+			bool m_abbreviations{false};  // Accept unambiguous prefixes of option names
+			bool m_inline_values{false};  // Accept values attached with '=', e.g. --level=5
+			bool m_bundled_flags{false};  // Accept several flags in one token, e.g. -abc
+			unsigned m_validation_threads{DEFAULT_VALIDATION_THREADS};  // Threads running the value validators
+			Memory_Resource *m_resource{default_resource()};  // Source of parser-owned storage
+			std::string m_env_prefix;  // Prefix of the derived environment variable names
 		public:
+			/** Default maximum number of threads that run validators at once */
+			static constexpr unsigned DEFAULT_VALIDATION_THREADS{32};
+
 			Options() noexcept { }
 
 			Options &auto_help(bool auto_help) noexcept {
 				m_auto_help = auto_help;
 				return *this;
 			}
+
+			/**
+			 * Store parsed values as non-owning views into the argv passed to
+			 * parse_args() instead of copying them into parser-owned storage.
+			 *
+			 * The argv strings must then remain valid for as long as argument values
+			 * are retrieved.
+			 */
+			Options &zero_copy(bool zero_copy) noexcept {
+				m_zero_copy = zero_copy;
+				return *this;
+			}
+
+			/**
+			 * Accept any unambiguous prefix of a long option name in place of the full
+			 * name, as GNU getopt_long() does (e.g. @a --verb for @a --verbose).
+			 *
+			 * A name that is defined always matches exactly, even if it is also the
+			 * prefix of other names. A prefix shared by several names is rejected as
+			 * ambiguous.
+			 */
+			Options &abbreviations(bool abbreviations) noexcept {
+				m_abbreviations = abbreviations;
+				return *this;
+			}
+
+			/**
+			 * Accept the value of an option attached to its name with '=' (e.g.
+			 * @a --level=5 or @a -l=5) in addition to the following token.
+			 *
+			 * The value refers to the part of the argv string after the '=', so
+			 * splitting the token does not copy or allocate. Everything after the
+			 * first '=' is the value, which may be empty.
+			 */
+			Options &inline_values(bool inline_values) noexcept {
+				m_inline_values = inline_values;
+				return *this;
+			}
+
+			/**
+			 * Accept several flags in a single token, as POSIX getopt() does (e.g.
+			 * @a -vfx for @a -v @a -f @a -x).
+			 *
+			 * If a flag in the token takes a value, the rest of the token is its value
+			 * (e.g. @a -vlinfo for @a -v @a -l @a info), or else the following token is.
+			 * A single-dash token that is the exact name of an option (e.g.
+			 * @a -verbose) still matches the option.
+			 */
+			Options &bundled_flags(bool bundled_flags) noexcept {
+				m_bundled_flags = bundled_flags;
+				return *this;
+			}
+
+			/**
+			 * Run the validators set with Argument_Info::validator() on at most the
+			 * given number of threads at once, including the calling thread.
+			 *
+			 * Validators usually wait on the file system or the network rather than
+			 * the CPU, so the default exceeds the number of hardware threads. A value
+			 * of 1 runs them one after another on the calling thread.
+			 */
+			Options &validation_threads(unsigned n_threads) noexcept {
+				m_validation_threads = std::max(n_threads, 1u);
+				return *this;
+			}
+
+			/**
+			 * Allocate the argument definitions, name index and parsed values from the
+			 * given memory resource instead of the default heap.
+			 *
+			 * Passing a monotonic arena (e.g. Monotonic_Buffer_Resource) places the
+			 * parser state in a few contiguous blocks that are released together. The
+			 * resource must outlive the parser. Argument names and help text are held in
+			 * @a std::string and are not allocated from the resource.
+			 */
+			Options &memory_resource(Memory_Resource *resource) noexcept {
+				m_resource = resource;
+				return *this;
+			}
+
+			/**
+			 * Read every optional argument without an explicit Optional_Info::env()
+			 * variable from the environment variable named by the prefix followed by
+			 * the reference name in uppercase, with dashes replaced by underscores
+			 * (e.g. @a APP_LOG_LEVEL for @a --log-level with prefix @a APP_).
+			 *
+			 * @see load_environment()
+			 */
+			Options &env_prefix(std::string prefix) {
+				m_env_prefix = std::move(prefix);
+				return *this;
+			}
 		};
 
 		/**
@@ -47,17 +171,25 @@ namespace cpparse {
 		 *
 		 * @param opts  configuration options
 		 */
-		Argument_Parser(const Options &opts = Options{})
-				: m_auto_help{opts.m_auto_help} {
-			if (m_auto_help) {
-				add_optional("-h", "--help", Optional_Info::Type::FLAG).help("display this help text");
-				set_help_handler([](const Argument_Parser &parser) {
-					parser.print_help();
-					std::exit(0);
-				});
-			} else {
-				set_help_handler([](const Argument_Parser &) noexcept { });
-			}
+		Argument_Parser(const Options &opts = Options{});
+
+		/**
+		 * Construct argument parser instance with the arguments defined by a static
+		 * schema.
+		 *
+		 * The schema has already been checked for invalid and duplicate names, so its
+		 * arguments are registered without validating them again. Additional
+		 * arguments can still be added with add_positional() and add_optional().
+		 *
+		 * @param schema  argument definitions created with make_static_schema()
+		 * @param opts    configuration options
+		 * @throw std::logic_error  If an argument conflicts with the '-h/--help' flag
+		 *                          added by Options::auto_help().
+		 */
+		template<std::size_t N>
+		explicit Argument_Parser(const Static_Schema<N> &schema, const Options &opts = Options{})
+				: Argument_Parser{opts} {
+			add_static(schema.begin(), schema.end());
 		}
 
 		/**
@@ -78,6 +210,7 @@ namespace cpparse {
 		template<class String>
 		void set_description(String &&description) noexcept {
 			m_description = std::forward<String>(description);
+			m_help_cache->invalidate();
 		}
 
 		/**
@@ -91,6 +224,24 @@ namespace cpparse {
 			m_help_handler = std::forward<Callable>(help_handler);
 		}
 
+		/**
+		 * Attach an observer to receive the metrics of each call to parse_args() and
+		 * each value retrieved, in this parser and the parsers of its subcommands.
+		 *
+		 * The observer is only called if the program is built with
+		 * CPARSEPARSE_INSTRUMENTATION defined.
+		 *
+		 * @param observer  observer, which must outlive the parser or be detached
+		 *                  first, or nullptr to detach the current one
+		 */
+		void set_observer(Parse_Observer *observer) noexcept {
+			m_observer = observer;
+			for (const auto &parser : m_subcommand_parsers) {
+				if (parser)
+					parser->set_observer(observer);
+			}
+		}
+
 		/**
 		 * Define a positional argument with the given name.
 		 *
@@ -106,15 +257,19 @@ namespace cpparse {
 		 *                          name.
 		 */
 		Positional_Info &add_positional(std::string name) {
-			if (!valid_positional_name(name))
+			if (!valid_positional_name(name.c_str()))
 				throw std::logic_error{lerrstr("invalid positional argument name '", name, "'")};
-			if (m_optional_args.find(name) != m_optional_args.end())
-				throw std::logic_error{lerrstr("positional argument name conflicts with optional argument reference name '", name, "'")};
-			const auto pair = m_positional_args.emplace(name, make_unique<Positional_Info>(name));
-			if (!pair.second)
+			const auto it = m_arg_index.find(name);
+			if (it != m_arg_index.end()) {
+				if (it->second.kind == Arg_Handle::Kind::OPTIONAL)
+					throw std::logic_error{lerrstr("positional argument name conflicts with optional argument reference name '", name, "'")};
 				throw std::logic_error{lerrstr("duplicate positional argument name '", name, "'")};
-			m_positional_order.push_back(std::move(name));
-			return *pair.first->second;
+			}
+			m_positional_args.emplace_back(std::move(name));
+			auto &positional = m_positional_args.back();
+			m_arg_index.emplace(positional.name(), Arg_Handle{Arg_Handle::Kind::POSITIONAL, m_positional_args.size() - 1});
+			attach_info(positional);
+			return positional;
 		}
 
 		/**
@@ -134,16 +289,21 @@ namespace cpparse {
 		 *                          argument name.
 		 */
 		Optional_Info &add_optional(std::string long_name, Optional_Info::Type type = Optional_Info::Type::SINGLE) {
-			auto formatted_name = format_option_name(long_name);
-			if (formatted_name.empty())
+			const auto formatted_name = long_option_name(long_name.c_str());
+			if (!formatted_name)
 				throw std::logic_error{lerrstr("invalid optional argument name: ", long_name)};
-			if (m_positional_args.find(formatted_name) != m_positional_args.end())
-				throw std::logic_error{lerrstr("optional argument reference name conflicts with positional argument name '", formatted_name, "'")};
-			const auto pair = m_optional_args.emplace(formatted_name, make_unique<Optional_Info>(formatted_name, type));
-			if (!pair.second)
+			const auto it = m_arg_index.find(formatted_name);
+			if (it != m_arg_index.end()) {
+				if (it->second.kind == Arg_Handle::Kind::POSITIONAL)
+					throw std::logic_error{lerrstr("optional argument reference name conflicts with positional argument name '", formatted_name, "'")};
 				throw std::logic_error{lerrstr("duplicate optional argument name '", formatted_name, "'")};
-			m_optional_order.push_back(std::move(formatted_name));
-			return *pair.first->second;
+			}
+			m_optional_args.emplace_back(formatted_name, type, m_resource);
+			auto &optional = m_optional_args.back();
+			m_arg_index.emplace(optional.name(), Arg_Handle{Arg_Handle::Kind::OPTIONAL, m_optional_args.size() - 1});
+			m_option_trie.insert(optional.name(), m_optional_args.size() - 1);
+			attach_info(optional);
+			return optional;
 		}
 
 		/**
@@ -166,17 +326,48 @@ namespace cpparse {
 		 */
 		template<class String>
 		Optional_Info &add_optional(std::string flag, String &&long_name, Optional_Info::Type type = Optional_Info::Type::SINGLE) {
-			const auto formatted_name = format_flag_name(flag);
+			const auto formatted_name = flag_option_name(flag.c_str());
 			if (!formatted_name)
 				throw std::logic_error{lerrstr("invalid flag name '", flag, "'")};
-			if (m_flags.find(formatted_name) != m_flags.end())
+			if (m_flag_table[flag_index(formatted_name)] != NO_INDEX)
 				throw std::logic_error{lerrstr("duplicate flag name '", flag, "'")};
 			auto &optional = add_optional(std::forward<String>(long_name), std::move(type));
 			optional.set_flag(formatted_name);
-			m_flags.emplace(optional.flag(), optional.name()).first;
+			m_help_cache->invalidate();
+			m_flag_table[flag_index(formatted_name)] = m_optional_args.size() - 1;
 			return optional;
 		}
 
+		/**
+		 * Define a subcommand with the given name.
+		 *
+		 * The subcommand's arguments are defined by @a factory, which is only invoked
+		 * if the subcommand is selected on the command line. The first command-line
+		 * argument following this parser's positional arguments selects the
+		 * subcommand, and all arguments after it are parsed by the subcommand's
+		 * parser, which is retrieved with subcommand_parser().
+		 *
+		 * @tparam Factory  callable type, invoked as @a factory(parser)
+		 * @param name      subcommand name
+		 * @param factory   callable that defines the subcommand's arguments on the
+		 *                  given parser
+		 * @return a reference to this subcommand's Subcommand_Info object that can be
+		 *         used to set additional properties.
+		 * @throw std::logic_error  If @a name is not in the correct format or it is a
+		 *                          duplicate.
+		 */
+		template<class Factory>
+		Subcommand_Info &add_subcommand(std::string name, Factory &&factory) {
+			if (!valid_positional_name(name.c_str()))
+				throw std::logic_error{lerrstr("invalid subcommand name '", name, "'")};
+			if (lookup_subcommand_index(name) != NO_INDEX)
+				throw std::logic_error{lerrstr("duplicate subcommand name '", name, "'")};
+			m_subcommands.emplace_back(std::move(name), std::forward<Factory>(factory));
+			auto &subcommand = m_subcommands.back();
+			attach_help_cache(subcommand);
+			return subcommand;
+		}
+
 		/**
 		 * Parse the user-provided command-line arguments and match the values to the
 		 * program arguments.
@@ -185,12 +376,20 @@ namespace cpparse {
 		 * the values. After the call, @a argc and @a argv are updated to refer to any
 		 * remaining command-line arguments not matched by the registered arguments.
 		 *
+		 * Matched values are copied into a single parser-owned buffer, unless the
+		 * parser was constructed with Options::zero_copy(), in which case they refer
+		 * directly to the strings in @a argv.
+		 *
+		 * If subcommands are defined, the remaining arguments following the
+		 * subcommand name are passed on to the subcommand's parser, and @a argc and
+		 * @a argv are updated to refer to any arguments that it did not match.
+		 *
 		 * @param argc  reference to command-line argument count
 		 * @param argv  reference to command-line argument strings
 		 * @throw std::runtime_error  If a positional argument is missing, a value for
-		 *                            an optional argument is missing, or an optional
+		 *                            an optional argument is missing, an optional
 		 *                            argument value was supplied an incorrect number of
-		 *                            times.
+		 *                            times, or the subcommand is missing or unknown.
 		 */
 		void parse_args(int &argc, char **&argv) {
 			parse_args(argc, const_cast<const char **&>(argv));
@@ -200,8 +399,334 @@ namespace cpparse {
 		 * @see parse_args()
 		 */
 		void parse_args(int &argc, const char **&argv) {
-			errstr_set_script_name(argv[0]);
-			remove_matched(assign_user_args(argc, argv), argc, argv);
+			parse_bound(argc, argv, Bind_Target{nullptr, nullptr});
+		}
+
+		/**
+		 * Parse the command-line arguments as parse_args(int &, const char **&) does,
+		 * and also write the values of the arguments bound to members of @a Struct
+		 * with Argument_Info::bind() into @a target.
+		 *
+		 * Variables bound by reference are written by every overload of
+		 * parse_args().
+		 *
+		 * @tparam Struct  type of the object holding the bound members
+		 * @param argc     reference to command-line argument count
+		 * @param argv     reference to command-line argument strings
+		 * @param target   object to write the bound members of
+		 * @throw std::runtime_error  If parse_args() would throw, or a bound value
+		 *                            cannot be converted to the type of its variable.
+		 * @throw std::logic_error    If an argument is bound to a member of a
+		 *                            different type.
+		 */
+		template<class Struct>
+		void parse_args(int &argc, char **&argv, Struct &target) {
+			parse_args(argc, const_cast<const char **&>(argv), target);
+		}
+
+		/**
+		 * @see parse_args(int &, char **&, Struct &)
+		 */
+		template<class Struct>
+		void parse_args(int &argc, const char **&argv, Struct &target) {
+			parse_bound(argc, argv, Bind_Target{&target, type_key<Struct>()});
+		}
+
+		/**
+		 * Parse the user-provided command-line arguments into a separate result
+		 * object, without modifying the parser.
+		 *
+		 * Unlike parse_args(), this function does not store the values in the
+		 * argument info objects or update the parser's script name, so any number
+		 * of threads may call it concurrently on the same parser, as long as
+		 * none of them modifies the parser's definitions. Error messages are
+		 * prefixed with @a argv[0]. The help handler is not invoked: matching
+		 * instead stops at '-h/--help', without requiring the remaining arguments,
+		 * and the caller can check for it with Parse_Result::has_arg("help") and
+		 * display help_text(argv[0]).
+		 *
+		 * Matched values are copied into storage owned by the result, unless the
+		 * parser was constructed with Options::zero_copy(). Parsing stops at a
+		 * subcommand name, and the remaining arguments are available from
+		 * Parse_Result::subcommand_argv().
+		 *
+		 * @param argc      command-line argument count
+		 * @param argv      command-line argument strings
+		 * @param resource  memory resource from which the result is allocated, which
+		 *                  must not be shared with other threads unless it is
+		 *                  thread-safe [default: the default heap resource]
+		 * @return the matched values
+		 * @throw std::runtime_error  If a positional argument is missing, a value for
+		 *                            an optional argument is missing, an optional
+		 *                            argument value was supplied an incorrect number of
+		 *                            times, or the subcommand is missing or unknown.
+		 */
+		Parse_Result parse(int argc, const char *const *argv, Memory_Resource *resource = default_resource()) const;
+
+		/**
+		 * Parse command-line arguments read one at a time from a token source,
+		 * without modifying the parser.
+		 *
+		 * The arguments are never collected into an array: each value is copied
+		 * into storage owned by the result as it is matched, even if the parser was
+		 * constructed with Options::zero_copy(), and every other token is discarded
+		 * once it has been read. If a subcommand is selected, parsing stops after
+		 * its name and the remaining tokens are left in @a source, as it does after
+		 * '-h/--help'.
+		 *
+		 * @param script_name  script name prefixed to error messages
+		 * @param source       source of the command-line arguments following the
+		 *                     script name, e.g. a Stream_Source or a
+		 *                     Response_File_Source
+		 * @param resource     memory resource from which the result is allocated
+		 * @return the matched values
+		 * @throw std::runtime_error  If the arguments are invalid, as for
+		 *                            parse(int, const char *const *, Memory_Resource *),
+		 *                            or the source cannot be read.
+		 * @see parse(int, const char *const *, Memory_Resource *)
+		 */
+		Parse_Result parse(const char *script_name, Token_Source &source, Memory_Resource *resource = default_resource()) const;
+
+		/**
+		 * Check the command-line arguments without storing values or throwing.
+		 *
+		 * Intended for rejecting untrusted command lines in bulk: no values are
+		 * stored, and an invalid command line is reported by its error code and the
+		 * position of the offending token, without formatting a message. Unlike
+		 * parse(), '-h/--help' is accepted as an ordinary flag and does not stop
+		 * matching. Like parse(), validation stops at a subcommand name.
+		 *
+		 * Nothing is allocated unless the parser has more than 256 optional
+		 * arguments, and the function may be called concurrently on the same parser.
+		 *
+		 * @param argc  command-line argument count
+		 * @param argv  command-line argument strings
+		 * @return the outcome, which converts to true if the command line is valid
+		 * @see error_message() to format the message that parse() would throw
+		 */
+		Parse_Status validate(int argc, const char *const *argv) const;
+
+		/**
+		 * Parse the command-line arguments into a separate result object, reporting
+		 * invalid arguments in @a status instead of throwing.
+		 *
+		 * Behaves as parse(), except that '-h/--help' is matched as an ordinary flag
+		 * and does not stop matching. If the command line is
+		 * invalid, the returned result holds no values. Exceptions thrown by value
+		 * callbacks (see Optional_Info::on_value()) are still propagated.
+		 *
+		 * @param argc      command-line argument count
+		 * @param argv      command-line argument strings
+		 * @param status    set to the outcome of the parse
+		 * @param resource  memory resource from which the result is allocated
+		 * @return the matched values, or an empty result if @a status reports an
+		 *         error
+		 * @see parse(int, const char *const *, Memory_Resource *)
+		 */
+		Parse_Result try_parse(int argc, const char *const *argv, Parse_Status &status, Memory_Resource *resource = default_resource()) const {
+			return match_result(argc, argv, status, Help_Mode::MATCH, resource);
+		}
+
+		/**
+		 * Format the message describing a failed parse, as thrown by parse_args()
+		 * and parse().
+		 *
+		 * @param status       outcome of validate() or try_parse() with the same
+		 *                     parser and command line
+		 * @param script_name  script name to prefix the message with
+		 * @return the error message, or an empty string if @a status reports no
+		 *         error
+		 */
+		std::string error_message(const Parse_Status &status, const std::string &script_name) const;
+
+		/**
+		 * Clear the values matched by the last call to parse_args(), keeping the
+		 * argument definitions.
+		 *
+		 * The storage used for the values is kept, so parsing again with a similar
+		 * command line does not allocate. Calling reset() is optional, since
+		 * parse_args() also clears the previous values before matching.
+		 */
+		void reset() noexcept {
+			clear_values();
+		}
+
+		/**
+		 * Read the values of optional arguments from their environment variables.
+		 *
+		 * Each optional argument is read from the variable set with
+		 * Optional_Info::env(), or from the name derived with Options::env_prefix().
+		 * The values are copied into the parser once, and are used by every
+		 * following parse for the arguments that are not given on the command line,
+		 * in preference to values loaded by load_config(). Each variable holds a
+		 * single value, also for append-type arguments. Flags are set by the values
+		 * true, yes or on; any other value is rejected. If a value is rejected, none
+		 * of the variables are loaded.
+		 *
+		 * @throw std::runtime_error  If a flag variable has a value other than true,
+		 *                            yes or on.
+		 */
+		void load_environment();
+
+		/**
+		 * Read the values of optional arguments from a configuration file.
+		 *
+		 * The file is memory-mapped and read in a single pass. Each non-empty line
+		 * that does not start with '#' has the form @a name = value, where @a name
+		 * is an optional argument reference name and the value may be enclosed in
+		 * double quotes. Append-type arguments may be given on several lines; for
+		 * other arguments the last line wins. Flags are set by the values true, yes
+		 * or on. For the arguments it sets, a file replaces the values of any
+		 * previously loaded file. If any line is invalid, none of the file is loaded.
+		 *
+		 * The values are copied into the parser once, and are used by every
+		 * following parse for the arguments that are given neither on the command
+		 * line nor in the environment.
+		 *
+		 * @param path  configuration file path
+		 * @throw std::runtime_error  If the file cannot be read, a line is not of the
+		 *                            form @a name = value, a name is not an optional
+		 *                            argument, or a flag has a value other than true,
+		 *                            yes or on.
+		 */
+		void load_config(const std::string &path);
+
+		/**
+		 * Discard the values loaded by load_environment() and load_config(), and free
+		 * the memory holding them.
+		 *
+		 * Every load copies its values into the parser, and the values of earlier
+		 * loads are only replaced for the arguments that a new load sets. A program
+		 * that reloads its configuration, e.g. on SIGHUP, should therefore call this
+		 * first, so that the memory used does not grow with each reload and
+		 * arguments whose variable or line has since been removed fall back to their
+		 * defaults again.
+		 */
+		void clear_fallbacks() noexcept;
+
+		/**
+		 * Serialize the values matched by the last call to parse_args(), including
+		 * those of the selected subcommand, into a compact binary snapshot.
+		 *
+		 * A parser with the same argument definitions can later restore the values
+		 * with load_snapshot() instead of parsing the command line again, e.g. in
+		 * worker processes started by a supervisor. Snapshots are versioned and
+		 * written in native byte order, for use on the same machine.
+		 *
+		 * @return the snapshot blob
+		 * @throw std::length_error  If the snapshot would exceed 4 GiB.
+		 */
+		std::string snapshot() const;
+
+		/**
+		 * Write the snapshot returned by snapshot() to a file.
+		 *
+		 * @param path  file path
+		 * @throw std::runtime_error  If the file cannot be written.
+		 */
+		void save_snapshot(const std::string &path) const;
+
+		/**
+		 * Restore the values saved in a snapshot file, as if the command line they
+		 * were parsed from had been passed to parse_args().
+		 *
+		 * The file is memory-mapped, and the restored values refer directly to the
+		 * mapped strings without copying them, so the cost does not depend on the
+		 * size of the original command line. The mapping is kept until the next call
+		 * to load_snapshot() or until the parser is destroyed. Values bound with
+		 * Argument_Info::bind() are not written.
+		 *
+		 * @param path  file path
+		 * @throw std::runtime_error  If the file cannot be read, is not a valid
+		 *                            snapshot, or was saved by a parser with
+		 *                            different argument definitions.
+		 */
+		void load_snapshot(const std::string &path);
+
+		/**
+		 * Restore the values saved in a snapshot held in memory, e.g. in memory
+		 * shared with the process that saved it.
+		 *
+		 * The restored values refer directly to the strings in the snapshot, which
+		 * must remain valid for as long as values are retrieved.
+		 *
+		 * @param data  snapshot blob
+		 * @param size  size of the blob in bytes
+		 * @throw std::runtime_error  If the blob is not a valid snapshot, or was
+		 *                            saved by a parser with different argument
+		 *                            definitions.
+		 * @see load_snapshot(const std::string &)
+		 */
+		void load_snapshot(const char *data, std::size_t size);
+
+		/**
+		 * Move the values matched by the last call to parse_args(), including those
+		 * of the selected subcommand, into a single read-only region of memory.
+		 *
+		 * The values are compacted into a snapshot held in an anonymous shared
+		 * mapping, which is then write-protected, and every accessor reads from it
+		 * afterwards. Worker processes forked after sealing share the pages of the
+		 * region with the parent instead of duplicating the heap pages that held
+		 * the values as they are touched. The region is released by the next call to
+		 * seal() or load_snapshot(), or when the parser is destroyed; parsing again
+		 * replaces the sealed values with newly matched ones.
+		 *
+		 * @throw std::length_error  If the values would exceed 4 GiB.
+		 * @throw std::bad_alloc     If the region cannot be mapped.
+		 * @see snapshot()
+		 */
+		void seal();
+
+		/**
+		 * @return the region holding the values moved by seal(), or nullptr if the
+		 *         values have not been sealed since they were last parsed or
+		 *         restored from a snapshot
+		 */
+		const Shared_Region *sealed_region() const noexcept {
+			return m_sealed_region.get();
+		}
+
+		/**
+		 * Determine whether a subcommand was selected by the last call to
+		 * parse_args().
+		 *
+		 * @return true if a subcommand was selected, or false otherwise.
+		 */
+		bool has_subcommand() const noexcept {
+			return m_selected_subcommand != NO_INDEX;
+		}
+
+		/**
+		 * Retrieve the name of the subcommand selected by the last call to
+		 * parse_args().
+		 *
+		 * @return the subcommand name.
+		 * @throw std::logic_error  If no subcommand was selected.
+		 */
+		const std::string &subcommand() const {
+			if (!has_subcommand())
+				throw std::logic_error{lerrstr("no subcommand was selected")};
+			return m_subcommands[m_selected_subcommand].name();
+		}
+
+		/**
+		 * Retrieve the parser of the subcommand selected by the last call to
+		 * parse_args(), from which the subcommand's argument values can be retrieved.
+		 *
+		 * @return the subcommand's parser.
+		 * @throw std::logic_error  If no subcommand was selected.
+		 */
+		const Argument_Parser &subcommand_parser() const {
+			if (!has_subcommand())
+				throw std::logic_error{lerrstr("no subcommand was selected")};
+			return *m_subcommand_parsers[m_selected_subcommand];
+		}
+
+		/**
+		 * @see subcommand_parser()
+		 */
+		Argument_Parser &subcommand_parser() {
+			return const_cast<Argument_Parser &>(static_cast<const Argument_Parser *>(this)->subcommand_parser());
 		}
 
 		/**
@@ -289,6 +814,27 @@ namespace cpparse {
 			return values;
 		}
 
+		/**
+		 * Convert the list of values that the user supplied for the given optional
+		 * argument and write them to the output iterator.
+		 *
+		 * Conversion stops without throwing at the first value that cannot be parsed
+		 * as type @a T.
+		 *
+		 * @tparam T          type to parse arguments as.
+		 * @tparam Output_It  output iterator type.
+		 * @param name        optional argument reference name.
+		 * @param out         output iterator to write values to.
+		 * @return the number of values written, which is also the index of the first
+		 *         invalid value, and the conversion status.
+		 * @throw std::logic_error  If no optional argument with the specified name
+		 *                          exists.
+		 */
+		template<class T, class Output_It>
+		Bulk_Convert_Result args_into(const std::string &name, Output_It out) const {
+			return lookup_optional(name).as_type_into<T>(out);
+		}
+
 		/**
 		 * Retrieve the value of the user-supplied argument at the specified index.
 		 *
@@ -352,274 +898,515 @@ namespace cpparse {
 			return lookup_optional(name).count();
 		}
 
+		/**
+		 * Convert the user-supplied values of the given argument as type @a T once and
+		 * cache the results.
+		 *
+		 * Subsequent calls to arg(), arg_at() and args() with type @a T return the
+		 * cached values without parsing them again. The cache is cleared by the next
+		 * call to parse_args().
+		 *
+		 * @tparam T    type to parse arguments as.
+		 * @param name  positional or optional argument name. For optional arguments,
+		 *              the reference name (the value returned from add_optional())
+		 *              should be used.
+		 * @throw std::logic_error    If no positional or optional argument with the
+		 *                            specified name exists.
+		 * @throw std::runtime_error  If any value cannot be parsed as type @a T.
+		 */
+		template<class T>
+		void cache_arg(const std::string &name) {
+			const auto it = m_arg_index.find(name);
+			if (it == m_arg_index.end())
+				throw std::logic_error{lerrstr("no argument by the name '", name, "'")};
+			if (it->second.kind == Arg_Handle::Kind::OPTIONAL)
+				m_optional_args[it->second.index].cache<T>();
+			else
+				m_positional_args[it->second.index].cache<T>();
+		}
+
+		/**
+		 * Get the number of bytes the parser holds for the values of the given
+		 * argument.
+		 *
+		 * Counts the argument's value list or compact storage, its cached
+		 * conversions and the characters of its values in the parser's value
+		 * storage. Values given as views into argv with Options::zero_copy() or into
+		 * a snapshot do not count their characters.
+		 *
+		 * @param name  positional or optional argument name. For optional arguments,
+		 *              the reference name (the value returned from add_optional())
+		 *              should be used.
+		 * @return the number of bytes
+		 * @throw std::logic_error  If no positional or optional argument with the
+		 *                          specified name exists.
+		 */
+		std::size_t arg_footprint(const std::string &name) const;
+
+		/**
+		 * @return the number of bytes the parser holds for argument values: the
+		 *         footprint of every argument, plus the unused capacity of the value
+		 *         storage and the list of extra arguments
+		 * @see arg_footprint()
+		 */
+		std::size_t memory_footprint() const noexcept;
+
 		/**
 		 * Print usage text to stdout.
 		 *
+		 * The text is rendered once and reused until the argument definitions
+		 * change. It is written with a single call, without flushing the stream.
+		 *
 		 * @param out  output stream [default: @a std::cout]
 		 */
-		void print_usage(std::ostream &out = std::cout) const {
-			out << "Usage: " << _scriptname;
-			if (!m_optional_args.empty())
-				out << " [options]";
-			for (const auto &positional : m_positional_order)
-				out << " <" << positional << ">";
-			out << std::endl;
-		}
+		void print_usage(std::ostream &out = std::cout) const;
 
 		/**
 		 * Print help text to stdout.
 		 *
+		 * The text is rendered once and reused until the argument definitions
+		 * change. It is written with a single call, without flushing the stream.
+		 *
 		 * @param out  output stream [default: @a std::cout]
 		 */
-		void print_help(std::ostream &out = std::cout) const {
-			print_usage(out);
-			if (!m_description.empty())
-				out << std::endl << "  " << m_description << std::endl;
-			if (!m_positional_order.empty()) {
-				out << std::endl << "Positional arguments:" << std::endl;
-				for (const auto &positional : m_positional_order)
-					m_positional_args.at(positional)->print(20, out);
-			}
-			if (!m_optional_args.empty()) {
-				out << std::endl << "Options:" << std::endl;
-				for (const auto &optional : m_optional_order)
-					m_optional_args.at(optional)->print(30, out);
-			}
-		}
+		void print_help(std::ostream &out = std::cout) const;
+
+		/**
+		 * Render the help text for the given script name.
+		 *
+		 * Unlike print_help(), the text is rendered afresh without using the cached
+		 * text, so any number of threads may call this function concurrently, e.g.
+		 * after '-h/--help' is matched by parse().
+		 *
+		 * @param script_name  script name shown in the usage line
+		 * @return the help text
+		 */
+		std::string help_text(const std::string &script_name) const;
 
 	private:
+		friend class Parse_Result;
 
 		/**
-		 * Determine if the character is a valid start for an option name.
+		 * Handle referring to a registered argument by its kind and its index into
+		 * the corresponding argument store.
 		 */
-		static bool valid_option_char(char c) noexcept {
-			return !('0' <= c && c <= '9') && c != '-';
-		}
+		struct Arg_Handle {
+			enum class Kind { POSITIONAL, OPTIONAL };
+			Kind kind;
+			std::size_t index;
+		};
+
+		/** Special constant to indicate that no argument is associated with a flag */
+		static constexpr std::size_t NO_INDEX{static_cast<std::size_t>(-1)};
 
 		/**
-		 * Check whether the positional argument name is valid.
+		 * Values loaded for an optional argument from a fallback layer, used when the
+		 * argument is not given on the command line.
 		 */
-		static bool valid_positional_name(const std::string &name) {
-			std::cmatch m;
-			std::regex_match(name.c_str(), m, std::regex("\\w[a-zA-Z0-9_-]*"));
-			return !m.empty();
-		}
+		struct Fallback {
+			enum class Layer { NONE, CONFIG, ENVIRONMENT };  // In increasing precedence
+			using Values = std::vector<String_View, Resource_Allocator<String_View>>;
+
+			Layer layer;
+			unsigned generation;  // Load that set the values
+			Values values;
+		};
+
+		using Arg_Index = std::unordered_map<Hashed_String_View, Arg_Handle, Hashed_String_View::Hash, std::equal_to<Hashed_String_View>,
+				Resource_Allocator<std::pair<const Hashed_String_View, Arg_Handle>>>;
+
+		bool m_auto_help;
+		bool m_zero_copy;
+		bool m_abbreviations;
+		bool m_inline_values;
+		bool m_bundled_flags;
+		unsigned m_validation_threads;
+		Parse_Observer *m_observer{nullptr};  // Declared in every build, so the layout does not depend on the instrumentation
+		Parse_Metrics *m_metrics{nullptr};  // Metrics of the parse_args() call in progress
+		Memory_Resource *m_resource;
+		std::vector<const char *, Resource_Allocator<const char *>> m_extra_args;
+		Resource_Buffer m_value_storage;
+		std::unique_ptr<Help_Cache> m_help_cache;
+		std::unique_ptr<Mapped_File> m_snapshot_file;  // Holds the values restored by load_snapshot()
+		std::unique_ptr<Shared_Region> m_sealed_region;  // Holds the values moved by seal()
+		std::function<void(const Argument_Parser &)> m_help_handler;
+		std::string m_description;
+		std::unique_ptr<std::string> m_script_name;  // Script name given to the last parse, kept in place for the argument info objects
+		std::deque<Positional_Info, Resource_Allocator<Positional_Info>> m_positional_args;
+		std::deque<Optional_Info, Resource_Allocator<Optional_Info>> m_optional_args;
+		Arg_Index m_arg_index;
+		Option_Trie m_option_trie;  // Optional argument indices by reference name, for matching tokens
+		std::array<std::size_t, 256> m_flag_table;
+		std::deque<Subcommand_Info, Resource_Allocator<Subcommand_Info>> m_subcommands;
+		std::size_t m_selected_subcommand{NO_INDEX};
+		std::vector<std::unique_ptr<Argument_Parser>> m_subcommand_parsers;  // Built on first selection, by subcommand index
+		std::string m_env_prefix;
+		std::vector<Fallback, Resource_Allocator<Fallback>> m_fallbacks;  // By optional argument index
+		String_Arena m_fallback_storage;
+		unsigned m_load_generation{0};  // Incremented by each load of a fallback layer
 
 		/**
-		 * Check whether the optional argument name is valid.
+		 * Give a newly added argument access to the help cache, and invalidate it.
 		 */
-		static bool valid_option_name(const std::string &name) {
-			std::cmatch m;
-			std::regex_match(name.c_str(), m, std::regex("-([a-zA-Z_]|-?[a-zA-Z_][a-zA-Z0-9_-]+)"));
-			return !m.empty();
+		template<class Info>
+		void attach_help_cache(Info &info) noexcept {
+			info.m_help_cache = m_help_cache.get();
+			m_help_cache->invalidate();
 		}
 
 		/**
-		 * Format the option name by removing the any leading '-' characters.
+		 * Give a newly added positional or optional argument access to the help cache
+		 * and to the script name reported by its conversion errors.
 		 */
-		static std::string format_option_name(const std::string &name) {
-			std::cmatch m;
-			std::regex_match(name.c_str(), m, std::regex("--?([a-zA-Z_][a-zA-Z0-9_-]+)"));
-			return m.size() < 2 ? "" : m[1].str();
+		template<class Info>
+		void attach_info(Info &info) noexcept {
+			attach_help_cache(info);
+			info.m_script_name = m_script_name.get();
 		}
 
 		/**
-		 * Format the flag name by removing the leading '-' character.
+		 * Render the usage and help text, unless the cached text is still valid for
+		 * the current definitions and script name.
 		 */
-		static char format_flag_name(const std::string &name) {
-			std::cmatch m;
-			std::regex_match(name.c_str(), m, std::regex("-([a-zA-Z_])"));
-			return m.size() < 2 ? 0 : m[1].str()[0];
-		}
+		const Help_Cache &rendered_help() const;
+
+		/**
+		 * Render the usage and help text for the given script name into @a out.
+		 */
+		void render_help(const std::string &script_name, Help_Cache &out) const;
 
 		/**
-		 * Parsed argument token structure.
+		 * Register the arguments of a static schema without validating their names,
+		 * reserving the index storage for all of them first.
 		 */
-		struct Opt_Token {
-			enum class Type { OPT_NAME, OPT_VAL, FLAG };
-			Type type;
-			std::string value;
+		void add_static(const Static_Argument *first, const Static_Argument *last);
+
+		/**
+		 * Register an argument from a static schema under its precomputed name hash.
+		 */
+		void add_static(const Static_Argument &arg);
+
+		/**
+		 * Handling of '-h/--help' by match_tokens().
+		 *
+		 * INVOKE  invoke the help handler, for parse_args()
+		 *
+		 * STOP    set the flag and stop matching, so that the remaining arguments
+		 *         are not required, for parse()
+		 *
+		 * MATCH   match it as an ordinary flag
+		 */
+		enum class Help_Mode { INVOKE, STOP, MATCH };
+
+		/**
+		 * Receiver of the values matched by match_tokens() that assigns them to the
+		 * argument info objects, for parse_args().
+		 */
+		struct Info_Sink;
+
+		/**
+		 * Receiver of the values matched by match_tokens() that collects them in a
+		 * Parse_Result, for parse().
+		 *
+		 * Optional values are collected in command-line order along with their
+		 * argument index, and counted in the result's offsets, until store_result()
+		 * groups them by argument. When @a copy_values is set, each value is copied
+		 * into the result's storage as it is matched, since the token it was read
+		 * from does not outlive the next one.
+		 */
+		struct Result_Sink;
+
+		/**
+		 * Receiver of the values matched by match_tokens() that only records which
+		 * optional arguments were given, for validate().
+		 *
+		 * The record is kept inline unless there are more optional arguments than
+		 * fit, so that validating does not allocate.
+		 */
+		struct Validation_Sink;
+
+		/**
+		 * Cursor over the strings of an argv array, excluding the script name.
+		 *
+		 * Used in place of Argv_Source so that matching argv does not go through a
+		 * virtual call per token.
+		 */
+		struct Argv_Cursor;
+
+		/**
+		 * Value or further bundled flags following the option name in a token.
+		 */
+		struct Attached_Value;
+
+		/**
+		 * Determine if the token following an option that takes a value is another
+		 * option instead.
+		 */
+		bool looks_like_option(const char *token) const noexcept;
+
+		/**
+		 * Read the command-line tokens once, matching each token to its
+		 * corresponding parameter and passing the value to the sink.
+		 *
+		 * Values refer to the tokens read from @a source. Positional arguments beyond
+		 * those registered are collected as extra arguments, unless subcommands are
+		 * defined, in which case the first one selects the subcommand and ends
+		 * matching, leaving the tokens following it in @a source.
+		 *
+		 * Invalid command lines are reported in the returned status rather than by
+		 * throwing, so that rejecting one does not allocate; exceptions thrown by the
+		 * sink or the help handler are propagated.
+		 *
+		 * @param source       source of the tokens, with a @a next() function
+		 *                     returning the next token or nullptr at the end
+		 * @param help_mode    handling of '-h/--help'
+		 * @return the error, if any, or else the index of the subcommand name, or
+		 *         one past the last token if no subcommand was selected
+		 */
+		template<class Source, class Sink>
+		Parse_Status match_tokens(Source &source, Sink &sink, Help_Mode help_mode) const;
+
+		/**
+		 * Pass the values loaded from the environment or a configuration file to the
+		 * sink, for each optional argument not given on the command line.
+		 */
+		template<class Sink>
+		void add_fallbacks(Sink &sink) const;
+
+		/**
+		 * Verify that a value loaded from the environment or a configuration file
+		 * can be used for the optional argument. A flag has no false value, so it
+		 * only accepts the spellings of true.
+		 *
+		 * @param source  location of the value, used as the error message prefix
+		 * @throw std::runtime_error  If the value is not accepted.
+		 */
+		void check_fallback_value(const Optional_Info &optional, String_View value, const std::string &source) const;
+
+		/**
+		 * Store a value for the optional argument in a fallback layer.
+		 *
+		 * The value replaces those of lower-precedence layers and of earlier loads
+		 * of the same layer, and is ignored if a higher-precedence layer has been
+		 * loaded for the argument. Within a single load, it is appended if
+		 * @a append is set.
+		 */
+		void add_fallback(std::size_t index, Fallback::Layer layer, String_View value, unsigned generation, bool append);
+
+		/**
+		 * Match the command-line arguments, assigning the values to the argument info
+		 * objects. If matching fails, all values are cleared.
+		 *
+		 * @return the index of the subcommand name in @a argv, or @a argc if no
+		 *         subcommand was selected
+		 */
+		int match_args(int argc, const char **argv);
+
+		/**
+		 * Match the command-line arguments into a new result, which is left empty if
+		 * they are invalid.
+		 */
+		Parse_Result match_result(int argc, const char *const *argv, Parse_Status &status, Help_Mode help_mode, Memory_Resource *resource) const;
+
+		/**
+		 * Remove the values matched into a result, so that it reports no arguments
+		 * as given.
+		 */
+		static void discard_result(Parse_Result &result) noexcept;
+
+		/**
+		 * Create an empty result with a slot for each argument.
+		 */
+		Parse_Result make_result(const char *script_name, Memory_Resource *resource) const;
+
+		/**
+		 * Group the optional values matched into the result by argument, and copy all
+		 * values into storage owned by the result unless they have already been
+		 * copied or are stored as views into argv.
+		 *
+		 * The values are placed with a counting sort: the per-argument counts are
+		 * turned into end offsets, then each value is placed, last to first, just
+		 * before the end of its argument's range.
+		 */
+		void store_result(Parse_Result &result, const Result_Sink &sink) const;
+
+		/**
+		 * @return a hash of the argument names and types, which must match for a
+		 *         parser to restore another's snapshot
+		 */
+		std::uint32_t definition_fingerprint() const noexcept;
+
+		void write_snapshot_section(_Snapshot_Writer &writer) const;
+
+		void read_snapshot_section(_Snapshot_Reader &reader);
+
+		/**
+		 * Object whose members bound with Argument_Info::bind() are written by
+		 * parse_args().
+		 */
+		struct Bind_Target {
+			void *object;
+			const void *type;  // Key of the object's type, or nullptr if none was given
 		};
 
-		/** Map structure to store matched optional arguments */
-		using Matched_Opts = std::unordered_map<std::string, std::vector<std::string>>;
+		void parse_bound(int &argc, const char **&argv, const Bind_Target &target);
 
-		bool m_auto_help;
-		std::function<void(const Argument_Parser &)> m_help_handler;
-		std::string m_description;
-		std::vector<std::string> m_positional_order;
-		std::unordered_map<std::string, std::unique_ptr<Positional_Info>> m_positional_args;
-		std::vector<std::string> m_optional_order;
-		std::unordered_map<std::string, std::unique_ptr<Optional_Info>> m_optional_args;
-		std::unordered_map<char, std::string> m_flags;
+		/**
+		 * Write the stored values of every bound argument that was given into its
+		 * variable or member.
+		 */
+		void write_bindings(const Bind_Target &target) const;
+
+		template<class Info>
+		void write_binding(const Info &info, const Value_Range &values, const Bind_Target &target) const;
 
 		/**
-		 * Parse the command-line arguments into tokens and match/assign them to their
-		 * corresponding parameters.
+		 * Match and store the command-line arguments, dispatching those following a
+		 * subcommand name to the subcommand's parser, and write the bound values.
 		 */
-		std::vector<const char *> assign_user_args(int argc, const char **argv) {
-			std::vector<const char *> pos_args;
-			Matched_Opts opt_args;
-			std::tie(pos_args, opt_args) = match_args(argc, argv);
-			assign_matched_opt(std::move(opt_args));
-			return assign_matched_pos(std::move(pos_args));
-		}
+		void parse_tokens(int &argc, const char **&argv, const Bind_Target &target);
 
+#ifdef CPARSEPARSE_INSTRUMENTATION
 		/**
-		 * Assign the matched positional arguments to their corresponding parameters.
+		 * Parse the command-line arguments as parse_tokens() does, reporting the
+		 * metrics of the parse to the observer.
 		 */
-		std::vector<const char *> assign_matched_pos(const std::vector<const char *> &pos_args) {
-			for (std::size_t i = 0; i < m_positional_order.size(); ++i)
-				m_positional_args[m_positional_order[i]]->set_value(pos_args[i]);
-			return std::vector<const char *>(pos_args.data() + m_positional_order.size(), pos_args.data() + pos_args.size());
-		}
+		void observed_parse_tokens(int &argc, const char **&argv, const Bind_Target &target);
 
 		/**
-		 * Assign the matched optional arguments to their corresponding parameters.
+		 * Add the costs of matching and storing this parser's arguments to the
+		 * metrics of the parse in progress, if it is observed.
 		 */
-		void assign_matched_opt(Matched_Opts &&optional_args) {
-			for (auto &&pair : std::move(optional_args))
-				m_optional_args[pair.first]->set_values(std::move(pair.second));
-		}
+		void record_phases(int token_count, Instrumentation_Clock::time_point match_start, Instrumentation_Clock::time_point assign_start) noexcept;
+#endif /* CPARSEPARSE_INSTRUMENTATION */
 
 		/**
-		 * Parse the command-line arguments into tokens and match them to their
-		 * corresponding parameters.
+		 * Invoke the subcommand's factory to define its parser, unless the parser has
+		 * already been built by a previous parse.
+		 *
+		 * Built parsers are kept, so that selecting the subcommand again reuses its
+		 * definitions and storage.
 		 */
-		std::pair<std::vector<const char *>, Matched_Opts> match_args(int argc, const char **argv) const {
-			std::vector<const char *> pos_args;
-			std::vector<Opt_Token> opt_args;
-			std::tie(pos_args, opt_args) = tokenize_args(argc, argv);
-			return std::make_pair(pos_args, match_opt_args(opt_args));
-		}
+		Argument_Parser &build_subcommand_parser(std::size_t index);
 
 		/**
-		 * Match the tokenized arguments to their corresponding optional parameters.
+		 * Look up the subcommand with the given name.
+		 *
+		 * @return the subcommand index, or NO_INDEX if there is no such subcommand
 		 */
-		Matched_Opts match_opt_args(const std::vector<Opt_Token> &arg_tokens) const {
-			auto optional_args = init_matched_opt_args(arg_tokens);
-			const std::string *p_last_optional;
-			for (const auto &token : arg_tokens) {
-				switch (token.type) {
-				case Opt_Token::Type::OPT_NAME:
-					p_last_optional = &token.value;
-					break;
-				case Opt_Token::Type::OPT_VAL:
-					optional_args[*p_last_optional].push_back(std::move(token.value));
-					break;
-				case Opt_Token::Type::FLAG:
-					optional_args[token.value].push_back("true");
-					break;
-				}
+		std::size_t lookup_subcommand_index(String_View name) const noexcept {
+			for (std::size_t i = 0; i < m_subcommands.size(); ++i) {
+				if (m_subcommands[i].name() == name)
+					return i;
 			}
-			return optional_args;
+			return NO_INDEX;
 		}
 
 		/**
-		 * Initialize the map used to store matched optional arguments.
+		 * @return the script name shown in the usage text
 		 */
-		Matched_Opts init_matched_opt_args(const std::vector<Opt_Token> &arg_tokens) const {
-			Matched_Opts optional_args;
-			const auto optional_counts = count_opt_args(arg_tokens);
-			optional_args.reserve(optional_counts.size());
-			for (const auto &pair : optional_counts)
-				optional_args[pair.first].reserve(pair.second);
-			return optional_args;
+		const std::string &script_name() const noexcept {
+			return *m_script_name;
 		}
 
 		/**
-		 * Count the number of optional arguments from the token list.
+		 * Clear the values assigned by any previous parse, including those of the
+		 * subcommand parsers.
 		 */
-		std::unordered_map<std::string, std::size_t> count_opt_args(const std::vector<Opt_Token> &tokens) const {
-			std::unordered_map<std::string, std::size_t> optional_counts;
-			for (const auto &token : tokens) {
-				if (token.type == Opt_Token::Type::OPT_NAME || token.type == Opt_Token::Type::FLAG)
-					++optional_counts[token.value];
-			}
-			return optional_counts;
-		}
-
-		/**
-		 * Parse the command-line arguments into tokens that provide information for the
-		 * next parsing step.
-		 */
-		std::pair<std::vector<const char *>, std::vector<Opt_Token>> tokenize_args(int argc, const char **argv) const {
-			const std::vector<const char *> user_args(argv + 1, argv + argc);
-			std::vector<const char *> pos_args;
-			pos_args.reserve(user_args.size());
-			std::vector<Opt_Token> opt_tokens;
-			opt_tokens.reserve(user_args.size());
-
-			std::unordered_set<std::string> optional_names;
-			for (auto it = user_args.begin(); it != user_args.end(); ++it) {
-				auto optional_name = lookup_formatted_option_name(*it);
-				if (optional_name.empty()) {
-					pos_args.push_back(*it);
-				} else {
-					if (prematch_optional_arg(optional_name, optional_names.find(optional_name) != optional_names.end(), *std::next(it), *(user_args.end()))) {
-						opt_tokens.push_back(Opt_Token{Opt_Token::Type::OPT_NAME, optional_name});
-						opt_tokens.push_back(Opt_Token{Opt_Token::Type::OPT_VAL, *(++it)});
-					} else {
-						opt_tokens.push_back(Opt_Token{Opt_Token::Type::FLAG, optional_name});
-					}
-					optional_names.insert(optional_name);
-				}
-			}
-			if (pos_args.size() < m_positional_order.size())
-				throw std::runtime_error{errstr("requires positional argument '", m_positional_order[pos_args.size()], "'")};
+		void clear_values() noexcept;
 
-			return std::make_pair(pos_args, opt_tokens);
-		}
+		/**
+		 * Copy the matched values into a single parser-owned buffer and redirect the
+		 * value views to the copies, unless values are stored as views into argv.
+		 *
+		 * The buffer is only reallocated when a parse needs more space than any
+		 * previous one.
+		 */
+		void store_values();
+
+		/**
+		 * Convert the stored values of every argument with registered converters and
+		 * cache the results.
+		 *
+		 * @throw std::runtime_error  if a value cannot be converted
+		 */
+		void apply_converters();
 
 		/**
-		 * Look up the option name as either a flag or option argument and return the
-		 * formatted option name.
+		 * Run the validators of every argument on the stored values.
+		 *
+		 * @throw Validation_Error  if any value is rejected
 		 */
-		std::string lookup_formatted_option_name(const std::string &option_name) const {
-			const auto flag_name = format_flag_name(option_name);
-			if (flag_name) {
-				const auto flag_it = m_flags.find(flag_name);
-				if (flag_it == m_flags.end())
-					throw std::runtime_error{errstr("invalid flag '", option_name, "', pass --help to display possible options")};
-				return flag_it->second;
-			}
-			return format_option_name(option_name);
-		}
+		void run_validators() const;
 
 		/**
-		 * Perform initial validation/matching on the optional argument.
+		 * Footprint of a single argument, including the characters of its values in
+		 * the parser's value storage.
 		 */
-		bool prematch_optional_arg(const std::string &option_name, bool repeated, const char *next_arg, const char *args_end) const {
-			if (m_auto_help && option_name == "help")
-				m_help_handler(*this);
+		std::size_t positional_footprint(const Positional_Info &positional) const noexcept;
+		std::size_t optional_footprint(const Optional_Info &optional) const noexcept;
 
-			auto it = m_optional_args.find(option_name);
-			if (it == m_optional_args.end())
-				throw std::runtime_error{errstr("invalid option '", option_name, "', pass --help to display possible options")};
+		/**
+		 * @return the number of bytes the value takes in the parser's value storage,
+		 *         or 0 if it refers elsewhere
+		 */
+		std::size_t stored_size(String_View value) const noexcept;
 
-			if (it->second->type() == Optional_Info::Type::FLAG) {
-				if (repeated)
-					throw std::runtime_error{errstr("'", option_name, "' should only be specified once")};
-				return false;
-			} else {
-				if (next_arg == args_end)
-					throw std::runtime_error{errstr("'", option_name, "' requires a value")};
-				if (valid_option_name(next_arg))
-					throw std::runtime_error{errstr("'", option_name, "' requires a value")};
-				if (it->second->type() != Optional_Info::Type::APPEND && repeated)
-					throw std::runtime_error{errstr("'", option_name, "' should only be specified once")};
-				return true;
-			}
+		/**
+		 * Look up the optional argument referenced by the command-line token as either
+		 * a flag or option name.
+		 *
+		 * With inline values or bundled flags enabled, the token may also carry a
+		 * value or further flags after the option name, which are located within the
+		 * token without copying it.
+		 *
+		 * @param error     set to INVALID_FLAG or INVALID_OPTION if the token names an
+		 *                  unknown flag or option, or to AMBIGUOUS_OPTION if it
+		 *                  abbreviates several options
+		 * @param attached  set to the value or flags following the option name
+		 * @return the optional argument index, or NO_INDEX if the token is not an
+		 *         option name
+		 */
+		std::size_t lookup_option_index(const char *token, Parse_Error &error, Attached_Value &attached) const noexcept;
+
+		/**
+		 * Look up the optional argument with the flag character.
+		 *
+		 * @param error  set to INVALID_FLAG if no optional argument has the flag
+		 */
+		std::size_t lookup_flag_index(char flag, Parse_Error &error) const noexcept {
+			const auto index = m_flag_table[flag_index(flag)];
+			if (index == NO_INDEX)
+				error = Parse_Error::INVALID_FLAG;
+			return index;
 		}
 
+		/**
+		 * @return the option name within a token rejected by lookup_option_index(),
+		 *         without the leading dashes or any attached value
+		 */
+		static String_View token_option_name(const char *token) noexcept;
+
+		/**
+		 * @return the first flag character of a token rejected by
+		 *         lookup_option_index() that no optional argument has
+		 */
+		char unknown_flag(const char *token) const noexcept;
+
+		/**
+		 * @return the quoted reference names of the options that start with
+		 *         @a prefix, separated by commas
+		 */
+		std::string abbreviation_candidates(String_View prefix) const;
+
 		/**
 		 * Update the command-line argument variables to refer to any extra positional
 		 * arguments that have not been matched.
 		 */
-		void remove_matched(const std::vector<const char *> &extra_positional_args, int &argc, const char **&argv) const {
-			argc = extra_positional_args.size() + 1;
-			for (std::size_t i = 0; i < extra_positional_args.size(); ++i)
-				argv[i + 1] = extra_positional_args[i];
+		void remove_matched(int &argc, const char **&argv) const noexcept {
+			argc = m_extra_args.size() + 1;
+			for (std::size_t i = 0; i < m_extra_args.size(); ++i)
+				argv[i + 1] = m_extra_args[i];
 		}
 
 		/**
@@ -627,23 +1414,20 @@ namespace cpparse {
 		 * default value.
 		 */
 		template<class T, bool has_default>
-		T arg_at(const std::string &name, std::size_t idx, T &&default_val) const {
-			const auto opt_it = m_optional_args.find(name);
-			if (opt_it != m_optional_args.cend())
-				return opt_it->second->as_type_at<T, has_default>(idx, std::forward<T>(default_val));
-
-			const auto pos_it = m_positional_args.find(name);
-			if (pos_it != m_positional_args.cend())
-				return pos_it->second->as_type<T>();
-
-			throw std::logic_error{lerrstr("no argument by the name '", name, "'")};
-		}
+		T arg_at(const std::string &name, std::size_t idx, T &&default_val) const;
 
 		const Optional_Info &lookup_optional(const std::string &name) const {
-			const auto opt_it = m_optional_args.find(name);
-			if (opt_it == m_optional_args.end())
+			const auto it = m_arg_index.find(name);
+			if (it == m_arg_index.end() || it->second.kind != Arg_Handle::Kind::OPTIONAL)
 				throw std::logic_error{lerrstr("no optional argument by the name '", name, "'")};
-			return *opt_it->second;
+			return m_optional_args[it->second.index];
+		}
+
+		/**
+		 * Index into the flag table for the given flag character.
+		 */
+		static std::size_t flag_index(char flag) noexcept {
+			return static_cast<unsigned char>(flag);
 		}
 
 		Optional_Info &lookup_optional(const std::string &name) {
@@ -652,6 +1436,46 @@ namespace cpparse {
 
 	};
 
+	template<class T, bool has_default>
+	T Argument_Parser::arg_at(const std::string &name, std::size_t idx, T &&default_val) const {
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		const _Conversion_Timer timer{m_observer, name};
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		const auto it = m_arg_index.find(name);
+		if (it == m_arg_index.end())
+			throw std::logic_error{lerrstr("no argument by the name '", name, "'")};
+		if (it->second.kind == Arg_Handle::Kind::OPTIONAL)
+			return m_optional_args[it->second.index].as_type_at<T, has_default>(idx, std::forward<T>(default_val));
+		return m_positional_args[it->second.index].as_type<T>();
+	}
+
+/**
+ * Explicitly instantiate the value retrieval functions for type @a T, or declare
+ * the instantiations if @a EXTERN is @a extern.
+ */
+#define CPARSEPARSE_INSTANTIATE_VALUE_TYPE(EXTERN, T) \
+	EXTERN template T Argument_Parser::arg_at<T, false>(const std::string &, std::size_t, T &&) const; \
+	EXTERN template T Argument_Parser::arg_at<T, true>(const std::string &, std::size_t, T &&) const; \
+	EXTERN template T Parse_Result::arg_at<T, false>(const std::string &, std::size_t, T &&) const; \
+	EXTERN template T Parse_Result::arg_at<T, true>(const std::string &, std::size_t, T &&) const;
+
+/**
+ * Invoke @a X with each value type instantiated in the cparseparse library.
+ */
+#define CPARSEPARSE_FOR_EACH_VALUE_TYPE(X) \
+	X(bool) X(char) X(short) X(unsigned short) X(int) X(unsigned int) X(long) X(unsigned long) \
+	X(long long) X(unsigned long long) X(float) X(double) X(long double) X(std::string) X(String_View)
+
+#ifdef CPARSEPARSE_LIBRARY
+#define CPARSEPARSE_DECLARE_VALUE_TYPE(T) CPARSEPARSE_INSTANTIATE_VALUE_TYPE(extern, T)
+	CPARSEPARSE_FOR_EACH_VALUE_TYPE(CPARSEPARSE_DECLARE_VALUE_TYPE)
+#undef CPARSEPARSE_DECLARE_VALUE_TYPE
+#endif /* CPARSEPARSE_LIBRARY */
+
 }
 
+#ifndef CPARSEPARSE_LIBRARY
+#include "cparseparse/impl/argument-parser.h"
+#endif /* CPARSEPARSE_LIBRARY */
+
 #endif /* CPARSEPARSE_ARGUMENT_PARSER */
@@ -0,0 +1,240 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_BATCH_PARSER_H_
+#define CPARSEPARSE_BATCH_PARSER_H_
+
+#include "cparseparse/argument-parser.h"
+#include "cparseparse/util/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Command line referring to an argv array owned by the caller, including the
+	 * script name.
+	 */
+	struct Command_Line {
+		int argc;
+		const char *const *argv;
+	};
+
+	inline Command_Line make_command_line(const Command_Line &line) noexcept {
+		return line;
+	}
+
+	/**
+	 * Refer to the command line held in a contiguous container of strings, e.g. a
+	 * @a std::vector<const char *>, including the script name.
+	 */
+	template<class Container>
+	Command_Line make_command_line(const Container &args) noexcept {
+		return Command_Line{static_cast<int>(args.size()), args.data()};
+	}
+
+	/**
+	 * Outcome of each command line checked by a Batch_Parser, in input order.
+	 */
+	class Batch_Result {
+	public:
+
+		/**
+		 * @return the number of command lines checked
+		 */
+		std::size_t size() const noexcept {
+			return m_statuses.size();
+		}
+
+		/**
+		 * @return the outcome for the command line at the given input index
+		 */
+		const Parse_Status &operator[](std::size_t line) const noexcept {
+			return m_statuses[line];
+		}
+
+		/**
+		 * @return the outcome of every command line, in input order
+		 */
+		const std::vector<Parse_Status> &statuses() const noexcept {
+			return m_statuses;
+		}
+
+		/**
+		 * @return the number of command lines that were rejected
+		 */
+		std::size_t failure_count() const noexcept {
+			return m_failure_count;
+		}
+
+		/**
+		 * @return true if every command line was valid, or false otherwise
+		 */
+		bool all_valid() const noexcept {
+			return m_failure_count == 0;
+		}
+
+	private:
+		friend class Batch_Parser;
+
+		std::vector<Parse_Status> m_statuses;
+		std::size_t m_failure_count{0};
+	};
+
+	/**
+	 * Validator or parser of many command lines at once against the definitions
+	 * of a single Argument_Parser, spreading the lines across a pool of threads.
+	 *
+	 * Each thread starts on its own contiguous share of the lines and, once done,
+	 * takes blocks of lines from the shares of the others, so that a few slow
+	 * lines do not hold up the rest of the batch. The calling thread takes part in
+	 * the work.
+	 *
+	 * The parser must outlive the batch parser and must not be modified while a
+	 * batch is in progress.
+	 */
+	class Batch_Parser {
+	public:
+
+		/** Number of lines taken from a share at a time */
+		static constexpr std::size_t BLOCK_SIZE{64};
+
+		/**
+		 * @param parser     parser defining the arguments
+		 * @param n_threads  number of threads to use, or 0 to use one per hardware
+		 *                   thread
+		 */
+		explicit Batch_Parser(const Argument_Parser &parser, unsigned n_threads = 0) noexcept
+				: m_parser{&parser},
+				  m_n_threads{n_threads ? n_threads : std::max(std::thread::hardware_concurrency(), 1u)} { }
+
+		/**
+		 * @return the maximum number of threads used per batch
+		 */
+		unsigned thread_count() const noexcept {
+			return m_n_threads;
+		}
+
+		/**
+		 * Check every command line with Argument_Parser::validate().
+		 *
+		 * @param lines  random-access collection of command lines, whose elements
+		 *               are either Command_Line objects or contiguous containers of
+		 *               strings accepted by make_command_line()
+		 * @return the outcome of each command line
+		 */
+		template<class Lines>
+		Batch_Result validate(const Lines &lines) const {
+			Batch_Result result;
+			result.m_statuses.resize(lines.size());
+			run(lines.size(), [&](std::size_t i) {
+				const auto line = make_command_line(lines[i]);
+				result.m_statuses[i] = m_parser->validate(line.argc, line.argv);
+			});
+			count_failures(result);
+			return result;
+		}
+
+		/**
+		 * Parse every command line with Argument_Parser::try_parse(), passing the
+		 * values of each valid one to a callback.
+		 *
+		 * The callback is invoked concurrently from the worker threads, in no
+		 * particular order, as @a on_result(line, result), where @a line is the
+		 * input index of the command line and @a result is its Parse_Result,
+		 * passed as an rvalue so that it may be kept. If the callback throws, the
+		 * remaining lines are abandoned and the first exception is rethrown once
+		 * all threads have stopped.
+		 *
+		 * @param lines      random-access collection of command lines, as for
+		 *                   validate()
+		 * @param on_result  callback receiving the values of each valid line
+		 * @return the outcome of each command line
+		 */
+		template<class Lines, class Callable>
+		Batch_Result parse(const Lines &lines, Callable &&on_result) const {
+			Batch_Result result;
+			result.m_statuses.resize(lines.size());
+			run(lines.size(), [&](std::size_t i) {
+				const auto line = make_command_line(lines[i]);
+				auto &status = result.m_statuses[i];
+				auto values = m_parser->try_parse(line.argc, line.argv, status);
+				if (status)
+					on_result(i, std::move(values));
+			});
+			count_failures(result);
+			return result;
+		}
+
+	private:
+
+		/** Assumed cache line size, to which each share is aligned */
+		static constexpr std::size_t CACHE_LINE{64};
+
+		/**
+		 * Range of lines initially assigned to one thread, from which other threads
+		 * may also take blocks.
+		 */
+		struct Share {
+			std::atomic<std::size_t> next;
+			std::size_t end;
+			char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];  // Keep each share on its own cache line
+		};
+		static_assert(sizeof(Share) == CACHE_LINE, "share must fill one cache line");
+
+		const Argument_Parser *m_parser;
+		unsigned m_n_threads;
+
+		/**
+		 * Run @a work on each line index in [0, @a n_lines) across the threads.
+		 *
+		 * If a thread cannot be started, its share is taken over by the others.
+		 */
+		template<class Work>
+		void run(std::size_t n_lines, Work &&work) const {
+			const auto n_blocks = (n_lines + BLOCK_SIZE - 1) / BLOCK_SIZE;
+			const auto n_workers = std::max<std::size_t>(std::min<std::size_t>(m_n_threads, n_blocks), 1);
+			/* new only aligns to a fundamental type, so the shares are placed on cache line boundaries by hand */
+			auto space = n_workers * sizeof(Share) + CACHE_LINE - 1;
+			std::unique_ptr<char[]> storage{new char[space]};
+			void *aligned = storage.get();
+			const auto shares = static_cast<Share *>(std::align(CACHE_LINE, n_workers * sizeof(Share), aligned, space));
+			for (std::size_t i = 0; i < n_workers; ++i) {
+				::new (static_cast<void *>(shares + i)) Share;
+				shares[i].next.store(n_lines * i / n_workers, std::memory_order_relaxed);
+				shares[i].end = n_lines * (i + 1) / n_workers;
+			}
+
+			run_workers(n_workers, [&](std::size_t self, const std::atomic<bool> &failed) {
+				for (std::size_t k = 0; k < n_workers; ++k) {
+					auto &share = shares[(self + k) % n_workers];
+					while (!failed.load(std::memory_order_relaxed)) {
+						const auto first = share.next.fetch_add(BLOCK_SIZE, std::memory_order_relaxed);
+						if (first >= share.end)
+							break;
+						const auto last = std::min(first + BLOCK_SIZE, share.end);
+						for (auto i = first; i < last; ++i)
+							work(i);
+					}
+				}
+			});
+		}
+
+		static void count_failures(Batch_Result &result) noexcept {
+			for (const auto &status : result.m_statuses) {
+				if (!status)
+					++result.m_failure_count;
+			}
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_BATCH_PARSER_H_ */
@@ -0,0 +1,1083 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_IMPL_ARGUMENT_PARSER_H_
+#define CPARSEPARSE_IMPL_ARGUMENT_PARSER_H_
+
+/*
+ * Definitions of the non-template Argument_Parser functions.
+ *
+ * Included at the end of argument-parser.h in the default header-only build,
+ * where the functions are inline. With CPARSEPARSE_LIBRARY defined, they are
+ * compiled once into the cparseparse library instead (see lib/src).
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "cparseparse/util/parallel.h"
+#include <bitset>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace cpparse {
+
+	struct Argument_Parser::Info_Sink {
+		Argument_Parser &parser;
+
+		void set_positional(std::size_t index, const char *value) {
+			parser.m_positional_args[index].set_value(value);
+		}
+
+		bool has_values(std::size_t index) const noexcept {
+			const auto &optional = parser.m_optional_args[index];
+			return optional.exists() || optional.m_delivered;
+		}
+
+		void add_value(std::size_t index, String_View value) {
+			auto &optional = parser.m_optional_args[index];
+			if (optional.deliver_value(value, *parser.m_script_name))
+				optional.m_delivered = true;
+			else
+				optional.add_value(value);
+		}
+
+		void set_flag(std::size_t index) {
+			parser.m_optional_args[index].add_value("true");
+		}
+
+		void add_extra(const char *value) {
+			parser.m_extra_args.push_back(value);
+		}
+
+		void select_subcommand(std::size_t index) noexcept {
+			parser.m_selected_subcommand = index;
+		}
+	};
+
+	struct Argument_Parser::Result_Sink {
+		using Matched = std::vector<std::pair<std::size_t, String_View>, Resource_Allocator<std::pair<std::size_t, String_View>>>;
+
+		Parse_Result &result;
+		Matched matched;
+		std::vector<bool, Resource_Allocator<bool>> delivered;  // By optional argument index, sized on first use
+		bool copy_values;
+
+		Result_Sink(Parse_Result &result, Memory_Resource *resource, bool copy_values)
+				: result(result),
+				  matched{Matched::allocator_type{resource}},
+				  delivered{Resource_Allocator<bool>{resource}},
+				  copy_values{copy_values} { }
+
+		String_View keep(String_View value) {
+			return copy_values ? result.m_storage.store(value) : value;
+		}
+
+		void set_positional(std::size_t index, const char *value) {
+			result.m_values[index] = keep(value);
+		}
+
+		bool has_values(std::size_t index) const noexcept {
+			return result.m_offsets[index] != 0 || (index < delivered.size() && delivered[index]);
+		}
+
+		void add_value(std::size_t index, String_View value) {
+			if (result.m_parser->m_optional_args[index].deliver_value(value, result.m_script_name)) {
+				if (delivered.size() <= index)
+					delivered.resize(result.m_offsets.size());
+				delivered[index] = true;
+				return;
+			}
+			matched.emplace_back(index, keep(value));
+			++result.m_offsets[index];
+		}
+
+		void set_flag(std::size_t index) {
+			matched.emplace_back(index, String_View{"true"});
+			++result.m_offsets[index];
+		}
+
+		void add_extra(const char *value) {
+			result.m_extra_args.push_back(keep(value));
+		}
+
+		void select_subcommand(std::size_t index) noexcept {
+			result.m_subcommand = index;
+		}
+	};
+
+	struct Argument_Parser::Validation_Sink {
+		static constexpr std::size_t INLINE_SIZE{256};
+
+		std::bitset<INLINE_SIZE> inline_given;
+		std::vector<bool> given;  // Used in place of inline_given for more optional arguments
+
+		explicit Validation_Sink(std::size_t optional_count)
+				: given(optional_count > INLINE_SIZE ? optional_count : 0) { }
+
+		void set_positional(std::size_t, const char *) noexcept { }
+
+		bool has_values(std::size_t index) const noexcept {
+			return given.empty() ? inline_given[index] : given[index];
+		}
+
+		void add_value(std::size_t index, String_View) noexcept {
+			set_flag(index);
+		}
+
+		void set_flag(std::size_t index) noexcept {
+			if (given.empty())
+				inline_given[index] = true;
+			else
+				given[index] = true;
+		}
+
+		void add_extra(const char *) noexcept { }
+
+		void select_subcommand(std::size_t) noexcept { }
+	};
+
+	struct Argument_Parser::Argv_Cursor {
+		int argc;
+		const char *const *argv;
+		int pos;  // Index of the next token
+
+		const char *next() noexcept {
+			return pos < argc ? argv[pos++] : nullptr;
+		}
+	};
+
+	struct Argument_Parser::Attached_Value {
+		const char *value;  // First character after the name (and '='), or nullptr if none
+		bool bundled;       // Whether @a value holds further flags, e.g. "bc" in "-abc"
+	};
+
+	CPARSEPARSE_INLINE Argument_Parser::Argument_Parser(const Options &opts)
+			: m_auto_help{opts.m_auto_help},
+			  m_zero_copy{opts.m_zero_copy},
+			  m_abbreviations{opts.m_abbreviations},
+			  m_inline_values{opts.m_inline_values},
+			  m_bundled_flags{opts.m_bundled_flags},
+			  m_validation_threads{opts.m_validation_threads},
+			  m_resource{opts.m_resource},
+			  m_extra_args{Resource_Allocator<const char *>{m_resource}},
+			  m_value_storage{m_resource},
+			  m_help_cache{make_unique<Help_Cache>()},
+			  m_script_name{make_unique<std::string>()},
+			  m_positional_args{Resource_Allocator<Positional_Info>{m_resource}},
+			  m_optional_args{Resource_Allocator<Optional_Info>{m_resource}},
+			  m_arg_index{0, Hashed_String_View::Hash{}, std::equal_to<Hashed_String_View>{}, Arg_Index::allocator_type{m_resource}},
+			  m_option_trie{m_resource},
+			  m_subcommands{Resource_Allocator<Subcommand_Info>{m_resource}},
+			  m_env_prefix{opts.m_env_prefix},
+			  m_fallbacks{Resource_Allocator<Fallback>{m_resource}},
+			  m_fallback_storage{m_resource} {
+		m_flag_table.fill(std::size_t{NO_INDEX});
+		if (m_auto_help) {
+			add_optional("-h", "--help", Optional_Info::Type::FLAG).help("display this help text");
+			set_help_handler([](const Argument_Parser &parser) {
+				parser.print_help();
+				std::exit(0);
+			});
+		} else {
+			set_help_handler([](const Argument_Parser &) noexcept { });
+		}
+	}
+
+	CPARSEPARSE_INLINE Parse_Result Argument_Parser::parse(int argc, const char *const *argv, Memory_Resource *resource) const {
+		Parse_Status status;
+		auto result = match_result(argc, argv, status, Help_Mode::STOP, resource);
+		if (!status)
+			throw std::runtime_error{error_message(status, result.m_script_name)};
+		return result;
+	}
+
+	CPARSEPARSE_INLINE Parse_Result Argument_Parser::parse(const char *script_name, Token_Source &source, Memory_Resource *resource) const {
+		auto result = make_result(script_name, resource);
+		Result_Sink sink{result, resource, true};
+		const auto status = match_tokens(source, sink, Help_Mode::STOP);
+		if (!status)
+			throw std::runtime_error{error_message(status, result.m_script_name)};
+		store_result(result, sink);
+		return result;
+	}
+
+	CPARSEPARSE_INLINE Parse_Status Argument_Parser::validate(int argc, const char *const *argv) const {
+		Validation_Sink sink{m_optional_args.size()};
+		Argv_Cursor cursor{argc, argv, 1};
+		return match_tokens(cursor, sink, Help_Mode::MATCH);
+	}
+
+	CPARSEPARSE_INLINE std::string Argument_Parser::error_message(const Parse_Status &status, const std::string &script_name) const {
+		switch (status.error) {
+		case Parse_Error::INVALID_FLAG:
+			if (flag_option_name(status.token))
+				return script_errstr(script_name, "invalid flag '", status.token, "', pass --help to display possible options");
+			return script_errstr(script_name, "invalid flag '-", unknown_flag(status.token), "' in '", status.token, "', pass --help to display possible options");
+		case Parse_Error::INVALID_OPTION:
+			return script_errstr(script_name, "invalid option '", token_option_name(status.token), "', pass --help to display possible options");
+		case Parse_Error::AMBIGUOUS_OPTION:
+			return script_errstr(script_name, "ambiguous option '", token_option_name(status.token), "' could match ",
+					abbreviation_candidates(token_option_name(status.token)), ", pass --help to display possible options");
+		case Parse_Error::UNEXPECTED_VALUE:
+			return script_errstr(script_name, "'", m_optional_args[status.argument].name(), "' does not take a value");
+		case Parse_Error::MISSING_VALUE:
+			return script_errstr(script_name, "'", m_optional_args[status.argument].name(), "' requires a value");
+		case Parse_Error::REPEATED_ARGUMENT:
+			return script_errstr(script_name, "'", m_optional_args[status.argument].name(), "' should only be specified once");
+		case Parse_Error::MISSING_POSITIONAL:
+			return script_errstr(script_name, "requires positional argument '", m_positional_args[status.argument].name(), "'");
+		case Parse_Error::INVALID_SUBCOMMAND:
+			return script_errstr(script_name, "invalid subcommand '", status.token, "', pass --help to display possible subcommands");
+		case Parse_Error::MISSING_SUBCOMMAND:
+			return script_errstr(script_name, "requires a subcommand, pass --help to display possible subcommands");
+		case Parse_Error::NONE:
+			break;
+		}
+		return std::string{};
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::load_environment() {
+		std::vector<std::pair<std::size_t, String_View>> loaded;
+		std::string derived_name;
+		for (std::size_t i = 0; i < m_optional_args.size(); ++i) {
+			const auto &optional = m_optional_args[i];
+			auto p_name = &optional.env();
+			if (p_name->empty()) {
+				if (m_env_prefix.empty() || (m_auto_help && optional.name() == "help"))
+					continue;
+				derived_name = m_env_prefix;
+				append_env_name(optional.name(), derived_name);
+				p_name = &derived_name;
+			}
+			const auto value = std::getenv(p_name->c_str());
+			if (value) {
+				check_fallback_value(optional, value, *p_name);
+				loaded.emplace_back(i, value);
+			}
+		}
+
+		/* Only store the values once every variable has been checked */
+		const auto generation = ++m_load_generation;
+		for (const auto &value : loaded)
+			add_fallback(value.first, Fallback::Layer::ENVIRONMENT, value.second, generation, false);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::load_config(const std::string &path) {
+		const Mapped_File file{path};
+		std::vector<std::pair<std::size_t, String_View>> loaded;
+		const auto end = file.data() + file.size();
+		std::size_t line_number{0};
+		for (auto p_line = file.data(); p_line != end; ) {
+			++line_number;
+			auto p_eol = static_cast<const char *>(std::memchr(p_line, '\n', end - p_line));
+			if (!p_eol)
+				p_eol = end;
+			const auto line = trim_whitespace(String_View{p_line, static_cast<std::size_t>(p_eol - p_line)});
+			p_line = p_eol == end ? end : p_eol + 1;
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			const auto equals = line.find('=');
+			if (equals == std::string::npos)
+				throw std::runtime_error{script_errstr(path + ':' + std::to_string(line_number), "expected 'name = value'")};
+			const auto name = trim_whitespace(line.substr(0, equals));
+			auto value = trim_whitespace(line.substr(equals + 1));
+			if (value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"')
+				value = value.substr(1, value.size() - 2);
+			const auto it = m_arg_index.find(name);
+			if (it == m_arg_index.end() || it->second.kind != Arg_Handle::Kind::OPTIONAL)
+				throw std::runtime_error{script_errstr(path + ':' + std::to_string(line_number), "unknown option '", name, "'")};
+			const auto index = it->second.index;
+			check_fallback_value(m_optional_args[index], value, path + ':' + std::to_string(line_number));
+			loaded.emplace_back(index, value);
+		}
+
+		/* Only store the values once the whole file has been read */
+		const auto generation = ++m_load_generation;
+		for (const auto &value : loaded)
+			add_fallback(value.first, Fallback::Layer::CONFIG, value.second, generation, m_optional_args[value.first].type() == Optional_Info::Type::APPEND);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::clear_fallbacks() noexcept {
+		m_fallbacks.clear();
+		m_fallback_storage.clear();
+	}
+
+	CPARSEPARSE_INLINE std::string Argument_Parser::snapshot() const {
+		_Snapshot_Writer writer;
+		write_snapshot_section(writer);
+		return writer.finish();
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::save_snapshot(const std::string &path) const {
+		const auto blob = snapshot();
+		std::ofstream out{path, std::ios::binary | std::ios::trunc};
+		out.write(blob.data(), blob.size());
+		out.close();
+		if (!out)
+			throw std::runtime_error{"cannot write file '" + path + "'"};
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::load_snapshot(const std::string &path) {
+		std::unique_ptr<Mapped_File> file{new Mapped_File{path}};
+		load_snapshot(file->data(), file->size());
+		m_snapshot_file = std::move(file);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::load_snapshot(const char *data, std::size_t size) {
+		clear_values();
+		m_snapshot_file.reset();
+		m_sealed_region.reset();
+		try {
+			_Snapshot_Reader reader{data, size};
+			read_snapshot_section(reader);
+			if (!reader.done())
+				_Snapshot_Reader::fail("unexpected data after the last section");
+		} catch (...) {
+			clear_values();
+			throw;
+		}
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::seal() {
+		const auto blob = snapshot();
+		std::unique_ptr<Shared_Region> region{new Shared_Region{blob.data(), blob.size()}};
+		load_snapshot(region->data(), region->size());
+		m_sealed_region = std::move(region);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::print_usage(std::ostream &out) const {
+		const auto &cache = rendered_help();
+		out.write(cache.usage.data(), cache.usage.size());
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::print_help(std::ostream &out) const {
+		const auto &cache = rendered_help();
+		out.write(cache.help.data(), cache.help.size());
+	}
+
+	CPARSEPARSE_INLINE std::string Argument_Parser::help_text(const std::string &script_name) const {
+		Help_Cache text;
+		render_help(script_name, text);
+		return std::move(text.help);
+	}
+
+	CPARSEPARSE_INLINE const Help_Cache &Argument_Parser::rendered_help() const {
+		auto &cache = *m_help_cache;
+		if (cache.valid && cache.script_name == script_name())
+			return cache;
+		render_help(script_name(), cache);
+		return cache;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::render_help(const std::string &script_name, Help_Cache &out) const {
+		out.script_name = script_name;
+		auto &usage = out.usage;
+		usage.clear();
+		usage += "Usage: ";
+		usage += out.script_name;
+		if (!m_optional_args.empty())
+			usage += " [options]";
+		for (const auto &positional : m_positional_args) {
+			usage += " <";
+			usage += positional.name();
+			usage += '>';
+		}
+		if (!m_subcommands.empty())
+			usage += " <subcommand> ...";
+		usage += '\n';
+
+		auto &help = out.help;
+		help = usage;
+		if (!m_description.empty()) {
+			help += "\n  ";
+			help += m_description;
+			help += '\n';
+		}
+		if (!m_positional_args.empty()) {
+			help += "\nPositional arguments:\n";
+			for (const auto &positional : m_positional_args)
+				positional.render(20, help);
+		}
+		if (!m_subcommands.empty()) {
+			help += "\nSubcommands:\n";
+			for (const auto &subcommand : m_subcommands)
+				subcommand.render(20, help);
+		}
+		if (!m_optional_args.empty()) {
+			help += "\nOptions:\n";
+			for (const auto &optional : m_optional_args)
+				optional.render(30, help);
+		}
+		out.valid = true;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::add_static(const Static_Argument *first, const Static_Argument *last) {
+		std::size_t optional_count{0};
+		std::size_t optional_chars{0};
+		for (auto arg = first; arg != last; ++arg) {
+			if (arg->kind == Static_Argument::Kind::OPTIONAL) {
+				++optional_count;
+				optional_chars += arg->name_size;
+			}
+		}
+		m_arg_index.reserve(m_arg_index.size() + static_cast<std::size_t>(last - first));
+		m_option_trie.reserve(optional_count, optional_chars);
+		for (; first != last; ++first)
+			add_static(*first);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::add_static(const Static_Argument &arg) {
+		const String_View name{arg.name, arg.name_size};
+		if (arg.kind == Static_Argument::Kind::POSITIONAL) {
+			m_positional_args.emplace_back(std::string(arg.name, arg.name_size));
+			if (!m_arg_index.emplace(Hashed_String_View{m_positional_args.back().name(), arg.hash},
+					Arg_Handle{Arg_Handle::Kind::POSITIONAL, m_positional_args.size() - 1}).second) {
+				m_positional_args.pop_back();
+				throw std::logic_error{lerrstr("positional argument name conflicts with optional argument reference name '", name, "'")};
+			}
+			attach_info(m_positional_args.back());
+			return;
+		}
+
+		if (arg.flag && m_flag_table[flag_index(arg.flag)] != NO_INDEX)
+			throw std::logic_error{lerrstr("duplicate flag name '-", arg.flag, "'")};
+		m_optional_args.emplace_back(std::string(arg.name, arg.name_size), arg.type, m_resource);
+		auto &optional = m_optional_args.back();
+		if (!m_arg_index.emplace(Hashed_String_View{optional.name(), arg.hash}, Arg_Handle{Arg_Handle::Kind::OPTIONAL, m_optional_args.size() - 1}).second) {
+			m_optional_args.pop_back();
+			throw std::logic_error{lerrstr("duplicate optional argument name '", name, "'")};
+		}
+		m_option_trie.insert(optional.name(), m_optional_args.size() - 1);
+		if (arg.flag) {
+			optional.set_flag(arg.flag);
+			m_flag_table[flag_index(arg.flag)] = m_optional_args.size() - 1;
+		}
+		attach_info(optional);
+	}
+
+	CPARSEPARSE_INLINE bool Argument_Parser::looks_like_option(const char *token) const noexcept {
+		if (token[0] != '-')
+			return false;
+		if (valid_option_name(token))
+			return true;
+		const char *end{token};
+		return m_inline_values && (long_option_name(token, end) || (is_name_start_char(token[1]) && token[2] == '='));
+	}
+
+	template<class Source, class Sink>
+	Parse_Status Argument_Parser::match_tokens(Source &source, Sink &sink, Help_Mode help_mode) const {
+		std::size_t pos_count{0};
+		int pos{0};
+		while (const auto token = source.next()) {
+			++pos;
+			auto error = Parse_Error::NONE;
+			Attached_Value attached;
+			auto index = lookup_option_index(token, error, attached);
+			if (error != Parse_Error::NONE)
+				return Parse_Status{error, pos, NO_INDEX, token};
+			if (index == NO_INDEX) {
+				if (pos_count < m_positional_args.size()) {
+					sink.set_positional(pos_count++, token);
+				} else if (!m_subcommands.empty()) {
+					const auto subcommand = lookup_subcommand_index(token);
+					if (subcommand == NO_INDEX)
+						return Parse_Status{Parse_Error::INVALID_SUBCOMMAND, pos, NO_INDEX, token};
+					sink.select_subcommand(subcommand);
+					add_fallbacks(sink);
+					return Parse_Status{Parse_Error::NONE, pos, subcommand, token};
+				} else {
+					sink.add_extra(token);
+				}
+				continue;
+			}
+
+			/* Each flag of a bundle is matched in turn, until one takes a value */
+			for (;;) {
+				const auto &optional = m_optional_args[index];
+				const bool repeated = sink.has_values(index);
+				if (optional.type() == Optional_Info::Type::FLAG && attached.value && !attached.bundled)
+					return Parse_Status{Parse_Error::UNEXPECTED_VALUE, pos, index, token};
+				if (help_mode != Help_Mode::MATCH && m_auto_help && optional.name() == "help") {
+					if (help_mode == Help_Mode::INVOKE)
+						m_help_handler(*this);
+					else if (!repeated) {
+						sink.set_flag(index);
+						add_fallbacks(sink);
+						return Parse_Status{Parse_Error::NONE, pos + 1, NO_INDEX, nullptr};
+					}
+				}
+				if (optional.type() == Optional_Info::Type::FLAG) {
+					if (repeated)
+						return Parse_Status{Parse_Error::REPEATED_ARGUMENT, pos, index, token};
+					sink.set_flag(index);
+					if (!attached.value || !*attached.value)
+						break;
+					index = lookup_flag_index(*attached.value++, error);
+					if (error != Parse_Error::NONE)
+						return Parse_Status{error, pos, NO_INDEX, token};
+					continue;
+				}
+
+				const auto error_pos = pos;
+				String_View value;
+				if (attached.value && (*attached.value || !attached.bundled)) {
+					if (attached.bundled && m_inline_values && *attached.value == '=')
+						++attached.value;
+					value = String_View{attached.value, std::strlen(attached.value)};
+				} else {
+					const auto next = source.next();
+					if (!next || looks_like_option(next))
+						return Parse_Status{Parse_Error::MISSING_VALUE, error_pos, index, nullptr};
+					++pos;
+					value = String_View{next, std::strlen(next)};
+				}
+				if (optional.type() != Optional_Info::Type::APPEND && repeated)
+					return Parse_Status{Parse_Error::REPEATED_ARGUMENT, error_pos, index, nullptr};
+				sink.add_value(index, value);
+				break;
+			}
+		}
+		if (pos_count < m_positional_args.size())
+			return Parse_Status{Parse_Error::MISSING_POSITIONAL, pos + 1, pos_count, nullptr};
+		if (!m_subcommands.empty())
+			return Parse_Status{Parse_Error::MISSING_SUBCOMMAND, pos + 1, NO_INDEX, nullptr};
+		add_fallbacks(sink);
+		return Parse_Status{Parse_Error::NONE, pos + 1, NO_INDEX, nullptr};
+	}
+
+	template<class Sink>
+	void Argument_Parser::add_fallbacks(Sink &sink) const {
+		for (std::size_t i = 0; i < m_fallbacks.size(); ++i) {
+			if (sink.has_values(i))
+				continue;
+			for (const auto &value : m_fallbacks[i].values)
+				sink.add_value(i, value);
+		}
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::check_fallback_value(const Optional_Info &optional, String_View value, const std::string &source) const {
+		bool set;
+		if (optional.type() == Optional_Info::Type::FLAG && (convert_value<bool>(value, set) != Convert_Status::OK || !set))
+			throw std::runtime_error{script_errstr(source, "flag '", optional.name(), "' can only be set to true, yes or on")};
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::add_fallback(std::size_t index, Fallback::Layer layer, String_View value, unsigned generation, bool append) {
+		while (m_fallbacks.size() <= index)
+			m_fallbacks.push_back(Fallback{Fallback::Layer::NONE, 0, Fallback::Values{Fallback::Values::allocator_type{m_resource}}});
+		auto &fallback = m_fallbacks[index];
+		if (layer < fallback.layer)
+			return;
+		if (layer > fallback.layer || fallback.generation != generation || !append) {
+			fallback.values.clear();
+			fallback.layer = layer;
+			fallback.generation = generation;
+		}
+		fallback.values.push_back(m_fallback_storage.store(value));
+	}
+
+	CPARSEPARSE_INLINE int Argument_Parser::match_args(int argc, const char **argv) {
+		clear_values();
+		Parse_Status status;
+		try {
+			Info_Sink sink{*this};
+			Argv_Cursor cursor{argc, argv, 1};
+			status = match_tokens(cursor, sink, Help_Mode::INVOKE);
+		} catch (...) {
+			clear_values();
+			throw;
+		}
+		if (!status) {
+			clear_values();
+			throw std::runtime_error{error_message(status, *m_script_name)};
+		}
+		return status.index;
+	}
+
+	CPARSEPARSE_INLINE Parse_Result Argument_Parser::match_result(int argc, const char *const *argv, Parse_Status &status, Help_Mode help_mode, Memory_Resource *resource) const {
+		auto result = make_result(argv[0], resource);
+		Result_Sink sink{result, resource, false};
+		Argv_Cursor cursor{argc, argv, 1};
+		status = match_tokens(cursor, sink, help_mode);
+		if (!status) {
+			discard_result(result);
+			return result;
+		}
+		if (result.has_subcommand()) {
+			result.m_subcommand_argc = argc - status.index;
+			result.m_subcommand_argv = argv + status.index;
+		}
+		store_result(result, sink);
+		return result;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::discard_result(Parse_Result &result) noexcept {
+		result.m_positional_count = 0;
+		result.m_values.clear();
+		std::fill(result.m_offsets.begin(), result.m_offsets.end(), 0);
+		result.m_extra_args.clear();
+		result.m_subcommand = Parse_Result::NO_INDEX;
+	}
+
+	CPARSEPARSE_INLINE Parse_Result Argument_Parser::make_result(const char *script_name, Memory_Resource *resource) const {
+		Parse_Result result{*this, script_name, resource};
+		result.m_positional_count = m_positional_args.size();
+		result.m_values.resize(m_positional_args.size());
+		result.m_offsets.assign(m_optional_args.size() + 1, 0);
+		return result;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::store_result(Parse_Result &result, const Result_Sink &sink) const {
+		const auto &matched = sink.matched;
+		auto &offsets = result.m_offsets;
+		for (std::size_t i = 1; i < offsets.size(); ++i)
+			offsets[i] += offsets[i - 1];
+		offsets.back() = matched.size();
+		const auto positional_count = result.m_positional_count;
+		result.m_values.resize(positional_count + matched.size());
+		for (auto it = matched.rbegin(); it != matched.rend(); ++it)
+			result.m_values[positional_count + --offsets[it->first]] = it->second;
+		if (m_zero_copy || sink.copy_values)
+			return;
+
+		std::size_t total_size{0};
+		for (const auto &value : result.m_values)
+			total_size += value.size() + 1;
+		for (const auto &value : result.m_extra_args)
+			total_size += value.size() + 1;
+		result.m_storage.reserve(total_size);
+		for (auto &value : result.m_values)
+			value = result.m_storage.store(value);
+		for (auto &value : result.m_extra_args)
+			value = result.m_storage.store(value);
+	}
+
+	CPARSEPARSE_INLINE std::uint32_t Argument_Parser::definition_fingerprint() const noexcept {
+		_Fnv_Hash hash;
+		for (const auto &positional : m_positional_args)
+			hash.add(positional.name());
+		for (const auto &optional : m_optional_args) {
+			hash.add(optional.name());
+			hash.add(static_cast<char>(optional.type()));
+			hash.add(optional.flag());
+		}
+		for (const auto &subcommand : m_subcommands)
+			hash.add(subcommand.name());
+		return hash.value();
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::write_snapshot_section(_Snapshot_Writer &writer) const {
+		writer.put(definition_fingerprint());
+		writer.put_size(m_positional_args.size());
+		writer.put_size(m_optional_args.size());
+		writer.put_size(m_extra_args.size());
+		writer.put(m_selected_subcommand == NO_INDEX ? _SNAPSHOT_NO_SUBCOMMAND : static_cast<std::uint32_t>(m_selected_subcommand));
+		writer.put_string(*m_script_name);
+		for (const auto &positional : m_positional_args)
+			writer.put_string(positional.m_value);
+		for (const auto &optional : m_optional_args) {
+			writer.put_size(optional.count());
+			for (std::size_t i = 0; i < optional.count(); ++i)
+				writer.put_string(optional.m_values[i]);
+		}
+		for (const auto extra : m_extra_args)
+			writer.put_string(extra);
+		if (m_selected_subcommand != NO_INDEX)
+			m_subcommand_parsers[m_selected_subcommand]->write_snapshot_section(writer);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::read_snapshot_section(_Snapshot_Reader &reader) {
+		if (reader.get() != definition_fingerprint() || reader.get() != m_positional_args.size() || reader.get() != m_optional_args.size())
+			_Snapshot_Reader::fail("argument definitions differ from those of the saving parser");
+		const auto n_extra = reader.get();
+		const auto subcommand = reader.get();
+		if (subcommand != _SNAPSHOT_NO_SUBCOMMAND && subcommand >= m_subcommands.size())
+			_Snapshot_Reader::fail("unknown subcommand");
+		const auto script_name = reader.get_string();
+		m_script_name->assign(script_name.data(), script_name.size());
+		for (auto &positional : m_positional_args)
+			positional.set_value(reader.get_string());
+		for (auto &optional : m_optional_args) {
+			const auto count = reader.get();
+			for (std::uint32_t i = 0; i < count; ++i)
+				optional.add_value(reader.get_string());
+		}
+		for (std::uint32_t i = 0; i < n_extra; ++i)
+			m_extra_args.push_back(reader.get_string().data());
+		if (subcommand != _SNAPSHOT_NO_SUBCOMMAND) {
+			auto &parser = build_subcommand_parser(subcommand);
+			m_selected_subcommand = subcommand;
+			parser.read_snapshot_section(reader);
+		}
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::parse_bound(int &argc, const char **&argv, const Bind_Target &target) {
+		*m_script_name = argv[0];
+		m_sealed_region.reset();  // The values that referred to it are replaced by parse_tokens()
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		if (m_observer) {
+			observed_parse_tokens(argc, argv, target);
+			return;
+		}
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		parse_tokens(argc, argv, target);
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::write_bindings(const Bind_Target &target) const {
+		for (const auto &positional : m_positional_args) {
+			if (positional.m_binding)
+				write_binding(positional, Value_Range{&positional.m_value, 1}, target);
+		}
+		for (const auto &optional : m_optional_args) {
+			if (optional.m_binding && optional.exists())
+				write_binding(optional, optional.m_values.range(), target);
+		}
+	}
+
+	template<class Info>
+	void Argument_Parser::write_binding(const Info &info, const Value_Range &values, const Bind_Target &target) const {
+		if (info.m_bind_type && info.m_bind_type != target.type) {
+			if (!target.type)
+				throw std::logic_error{lerrstr("'", info.name(), "' is bound to a member, pass the object to write it to parse_args()")};
+			throw std::logic_error{lerrstr("'", info.name(), "' is bound to a member of a different type than the object passed to parse_args()")};
+		}
+		info.m_binding(target.object, values, *m_script_name, info.name());
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::parse_tokens(int &argc, const char **&argv, const Bind_Target &target) {
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		const auto match_start = Instrumentation_Clock::now();
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		const auto subcommand_pos = match_args(argc, argv);
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		const auto assign_start = Instrumentation_Clock::now();
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		store_values();
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		record_phases(subcommand_pos - 1, match_start, assign_start);
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		try {
+			apply_converters();
+			run_validators();
+			write_bindings(target);
+		} catch (...) {
+			clear_values();
+			throw;
+		}
+		if (m_selected_subcommand == NO_INDEX) {
+			remove_matched(argc, argv);
+			return;
+		}
+
+		try {
+			auto &parser = build_subcommand_parser(m_selected_subcommand);
+			int sub_argc = argc - subcommand_pos;
+			auto sub_argv = argv + subcommand_pos;
+#ifdef CPARSEPARSE_INSTRUMENTATION
+			parser.m_metrics = m_metrics;
+			struct Detach {
+				Argument_Parser &parser;
+				~Detach() {
+					parser.m_metrics = nullptr;
+				}
+			} detach{parser};
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+			parser.parse_tokens(sub_argc, sub_argv, target);
+
+			/* The subcommand's unmatched arguments become this parser's */
+			argc = sub_argc;
+			for (int i = 1; i < sub_argc; ++i)
+				argv[i] = sub_argv[i];
+		} catch (...) {
+			clear_values();
+			throw;
+		}
+	}
+
+#ifdef CPARSEPARSE_INSTRUMENTATION
+	CPARSEPARSE_INLINE void Argument_Parser::observed_parse_tokens(int &argc, const char **&argv, const Bind_Target &target) {
+		Parse_Metrics metrics{};
+		const auto start = Instrumentation_Clock::now();
+		const auto allocations_start = _allocation_stats();
+		const auto finish = [&] {
+			m_metrics = nullptr;
+			metrics.total = Instrumentation_Clock::now() - start;
+			metrics.allocation_count = _allocation_stats().count - allocations_start.count;
+			metrics.allocated_bytes = _allocation_stats().bytes - allocations_start.bytes;
+			m_observer->parse_finished(metrics);
+		};
+		m_metrics = &metrics;
+		try {
+			parse_tokens(argc, argv, target);
+		} catch (...) {
+			metrics.failed = true;
+			finish();
+			throw;
+		}
+		finish();
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::record_phases(int token_count, Instrumentation_Clock::time_point match_start, Instrumentation_Clock::time_point assign_start) noexcept {
+		if (!m_metrics)
+			return;
+		m_metrics->assign += Instrumentation_Clock::now() - assign_start;
+		m_metrics->match += assign_start - match_start;
+		m_metrics->token_count += token_count;
+		m_metrics->value_count += m_positional_args.size();
+		for (const auto &optional : m_optional_args)
+			m_metrics->value_count += optional.count();
+	}
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+
+	CPARSEPARSE_INLINE Argument_Parser &Argument_Parser::build_subcommand_parser(std::size_t index) {
+		if (m_subcommand_parsers.size() < m_subcommands.size())
+			m_subcommand_parsers.resize(m_subcommands.size());
+		auto &p_parser = m_subcommand_parsers[index];
+		if (!p_parser) {
+			std::unique_ptr<Argument_Parser> parser{new Argument_Parser{Options{}.auto_help(m_auto_help)
+					.zero_copy(m_zero_copy).abbreviations(m_abbreviations)
+					.inline_values(m_inline_values).bundled_flags(m_bundled_flags).validation_threads(m_validation_threads).memory_resource(m_resource).env_prefix(m_env_prefix)}};
+			m_subcommands[index].m_factory(*parser);
+			parser->m_observer = m_observer;
+			p_parser = std::move(parser);
+		}
+		auto &sub_script_name = *p_parser->m_script_name;
+		sub_script_name = script_name();
+		sub_script_name += ' ';
+		sub_script_name += m_subcommands[index].name();
+		return *p_parser;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::clear_values() noexcept {
+		for (auto &positional : m_positional_args)
+			positional.set_value(String_View{});
+		for (auto &optional : m_optional_args)
+			optional.clear_values();
+		m_extra_args.clear();
+		m_selected_subcommand = NO_INDEX;
+		for (auto &parser : m_subcommand_parsers) {
+			if (parser)
+				parser->clear_values();
+		}
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::store_values() {
+		if (m_zero_copy)
+			return;
+		std::size_t total_size{0};
+		for (const auto &positional : m_positional_args)
+			total_size += positional.m_value.size() + 1;
+		for (auto &optional : m_optional_args) {
+			if (optional.type() != Optional_Info::Type::FLAG) {
+				for (const auto &value : optional.m_values.views())
+					total_size += value.size() + 1;
+			}
+		}
+
+		m_value_storage.reserve(total_size);
+		auto p_next = m_value_storage.data();
+		auto store = [&p_next](String_View &value) {
+			std::memcpy(p_next, value.data(), value.size());
+			p_next[value.size()] = '\0';
+			value = String_View{p_next, value.size()};
+			p_next += value.size() + 1;
+		};
+		for (auto &positional : m_positional_args)
+			store(positional.m_value);
+		for (auto &optional : m_optional_args) {
+			if (optional.type() != Optional_Info::Type::FLAG) {
+				for (auto &value : optional.m_values.views())
+					store(value);
+			}
+		}
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::apply_converters() {
+		for (auto &positional : m_positional_args) {
+			if (!positional.m_converters.empty())
+				positional.m_converters.store_all(positional.m_cache, Value_Range{&positional.m_value, 1}, *m_script_name, positional.name());
+		}
+		for (auto &optional : m_optional_args) {
+			if (!optional.m_converters.empty() && optional.exists())
+				optional.m_converters.store_all(optional.m_cache, optional.m_values.range(), *m_script_name, optional.name());
+		}
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::arg_footprint(const std::string &name) const {
+		const auto it = m_arg_index.find(name);
+		if (it == m_arg_index.end())
+			throw std::logic_error{lerrstr("no argument by the name '", name, "'")};
+		if (it->second.kind == Arg_Handle::Kind::OPTIONAL)
+			return optional_footprint(m_optional_args[it->second.index]);
+		return positional_footprint(m_positional_args[it->second.index]);
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::memory_footprint() const noexcept {
+		std::size_t stored_size{0};
+		std::size_t bytes{m_extra_args.capacity() * sizeof(const char *)};
+		for (const auto &positional : m_positional_args) {
+			const auto footprint = positional_footprint(positional);
+			stored_size += footprint - positional.memory_footprint();
+			bytes += footprint;
+		}
+		for (const auto &optional : m_optional_args) {
+			const auto footprint = optional_footprint(optional);
+			stored_size += footprint - optional.memory_footprint();
+			bytes += footprint;
+		}
+		if (m_value_storage.capacity() > stored_size)
+			bytes += m_value_storage.capacity() - stored_size;
+		return bytes;
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::positional_footprint(const Positional_Info &positional) const noexcept {
+		return positional.memory_footprint() + stored_size(positional.m_value);
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::optional_footprint(const Optional_Info &optional) const noexcept {
+		std::size_t bytes{optional.memory_footprint()};
+		if (!optional.compact_storage() && optional.type() != Optional_Info::Type::FLAG) {
+			for (std::size_t i = 0; i < optional.count(); ++i)
+				bytes += stored_size(optional.m_values[i]);
+		}
+		return bytes;
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::stored_size(String_View value) const noexcept {
+		const auto storage = m_value_storage.data();
+		if (!storage || value.data() < storage || value.data() >= storage + m_value_storage.capacity())
+			return 0;
+		return value.size() + 1;
+	}
+
+	CPARSEPARSE_INLINE void Argument_Parser::run_validators() const {
+		struct Check {
+			const Optional_Info::Validator *validator;
+			const std::string *name;
+			String_View value;
+		};
+		std::vector<Check> checks;
+		const auto add_checks = [&checks](const std::vector<Optional_Info::Validator> &validators, const std::string &name, const Value_Range &values) {
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				for (const auto &validator : validators)
+					checks.push_back(Check{&validator, &name, values[i]});
+			}
+		};
+		for (const auto &positional : m_positional_args)
+			add_checks(positional.m_validators, positional.name(), Value_Range{&positional.m_value, 1});
+		for (const auto &optional : m_optional_args)
+			add_checks(optional.m_validators, optional.name(), optional.m_values.range());
+		if (checks.empty())
+			return;
+
+		std::vector<std::string> messages(checks.size());
+		parallel_for(checks.size(), m_validation_threads, [&](std::size_t i) {
+			messages[i] = (*checks[i].validator)(checks[i].value);
+		});
+		std::vector<Validation_Failure> failures;
+		for (std::size_t i = 0; i < checks.size(); ++i) {
+			if (!messages[i].empty())
+				failures.push_back(Validation_Failure{*checks[i].name, std::string{checks[i].value.data(), checks[i].value.size()}, std::move(messages[i])});
+		}
+		if (!failures.empty())
+			throw Validation_Error{*m_script_name, std::move(failures)};
+	}
+
+	CPARSEPARSE_INLINE std::size_t Argument_Parser::lookup_option_index(const char *token, Parse_Error &error, Attached_Value &attached) const noexcept {
+		attached = Attached_Value{nullptr, false};
+		const auto flag_name = flag_option_name(token);
+		if (flag_name || (m_inline_values && token[0] == '-' && is_name_start_char(token[1]) && token[2] == '=')) {
+			if (!flag_name)
+				attached.value = token + 3;
+			return lookup_flag_index(token[1], error);
+		}
+		const char *name_end{token};
+		const auto option_name = long_option_name(token, name_end);
+		if (!option_name || (*name_end && !m_inline_values))
+			return NO_INDEX;
+		const String_View name{option_name, static_cast<std::size_t>(name_end - option_name)};
+		if (m_bundled_flags && option_name == token + 1) {
+			/* An exact single-dash option name takes precedence over a bundle */
+			const auto index = m_option_trie.find(name);
+			if (index != Option_Trie::NO_MATCH) {
+				attached.value = *name_end ? name_end + 1 : nullptr;
+				return index;
+			}
+			attached = Attached_Value{token + 2, true};
+			return lookup_flag_index(token[1], error);
+		}
+		attached.value = *name_end ? name_end + 1 : nullptr;
+		const auto index = m_abbreviations ? m_option_trie.find_prefix(name) : m_option_trie.find(name);
+		if (index == Option_Trie::NO_MATCH) {
+			error = Parse_Error::INVALID_OPTION;
+			return NO_INDEX;
+		}
+		if (index == Option_Trie::AMBIGUOUS) {
+			error = Parse_Error::AMBIGUOUS_OPTION;
+			return NO_INDEX;
+		}
+		return index;
+	}
+
+	CPARSEPARSE_INLINE String_View Argument_Parser::token_option_name(const char *token) noexcept {
+		const char *end{token};
+		const auto name = long_option_name(token, end);
+		return String_View{name, static_cast<std::size_t>(end - name)};
+	}
+
+	CPARSEPARSE_INLINE char Argument_Parser::unknown_flag(const char *token) const noexcept {
+		auto flag = token + 1;
+		while (flag[1] && m_flag_table[flag_index(*flag)] != NO_INDEX)
+			++flag;
+		return *flag;
+	}
+
+	CPARSEPARSE_INLINE std::string Argument_Parser::abbreviation_candidates(String_View prefix) const {
+		std::string candidates;
+		for (const auto &optional : m_optional_args) {
+			if (optional.name().compare(0, prefix.size(), prefix.data(), prefix.size()) == 0) {
+				if (!candidates.empty())
+					candidates += ", ";
+				candidates += '\'';
+				candidates += optional.name();
+				candidates += '\'';
+			}
+		}
+		return candidates;
+	}
+
+	CPARSEPARSE_INLINE const std::string &Parse_Result::subcommand() const {
+		if (!has_subcommand())
+			throw std::logic_error{lerrstr("no subcommand was selected")};
+		return m_parser->m_subcommands[m_subcommand].name();
+	}
+
+	CPARSEPARSE_INLINE Parse_Result::Arg_Values Parse_Result::lookup(const std::string &name) const {
+		const auto it = m_parser->m_arg_index.find(name);
+		if (it == m_parser->m_arg_index.end())
+			throw std::logic_error{lerrstr("no argument by the name '", name, "'")};
+		if (it->second.kind == Argument_Parser::Arg_Handle::Kind::OPTIONAL)
+			return lookup_optional(name);
+		const auto index = it->second.index;
+		const auto &positional = m_parser->m_positional_args[index];
+		return Arg_Values{&positional.name(), &positional.converters(), m_values.data() + index, index < m_positional_count ? std::size_t{1} : 0, false};
+	}
+
+	CPARSEPARSE_INLINE Parse_Result::Arg_Values Parse_Result::lookup_optional(const std::string &name) const {
+		const auto it = m_parser->m_arg_index.find(name);
+		if (it == m_parser->m_arg_index.end() || it->second.kind != Argument_Parser::Arg_Handle::Kind::OPTIONAL)
+			throw std::logic_error{lerrstr("no optional argument by the name '", name, "'")};
+		const auto index = it->second.index;
+		const auto &optional = m_parser->m_optional_args[index];
+		const bool flag = optional.type() == Optional_Info::Type::FLAG;
+		if (index + 1 >= m_offsets.size())
+			return Arg_Values{&optional.name(), &optional.converters(), nullptr, 0, flag};
+		return Arg_Values{&optional.name(), &optional.converters(), m_values.data() + m_positional_count + m_offsets[index], m_offsets[index + 1] - m_offsets[index], flag};
+	}
+
+}
+
+#endif /* CPARSEPARSE_IMPL_ARGUMENT_PARSER_H_ */
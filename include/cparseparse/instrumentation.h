@@ -0,0 +1,190 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_INSTRUMENTATION_H_
+#define CPARSEPARSE_INSTRUMENTATION_H_
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace cpparse {
+
+	/** Clock used to time the phases of instrumented parses */
+	using Instrumentation_Clock = std::chrono::steady_clock;
+
+	/**
+	 * Costs of a single call to Argument_Parser::parse_args(), including the
+	 * parsing of any selected subcommand.
+	 */
+	struct Parse_Metrics {
+		std::chrono::nanoseconds match;   // Reading the tokens and matching them to arguments
+		std::chrono::nanoseconds assign;  // Copying the matched values into parser-owned storage
+		std::chrono::nanoseconds total;   // The whole call
+		std::size_t token_count;          // Command-line tokens read, excluding the script names
+		std::size_t value_count;          // Values matched to positional and optional arguments
+		std::size_t allocation_count;     // Allocations from memory resources for parser-owned storage
+		std::size_t allocated_bytes;      // Bytes requested by those allocations
+		bool failed;                      // Whether the call threw
+	};
+
+	/**
+	 * Cost of retrieving and converting a single value with Argument_Parser::arg(),
+	 * arg_at() or args().
+	 */
+	struct Conversion_Metrics {
+		const std::string *name;           // Argument name passed to the retrieval function
+		std::chrono::nanoseconds elapsed;  // Time spent, including lookups and any exception thrown
+	};
+
+	/**
+	 * Receiver of the metrics reported by a parser built with
+	 * CPARSEPARSE_INSTRUMENTATION defined, e.g. to feed a metrics system.
+	 *
+	 * Attached with Argument_Parser::set_observer(). The functions are called on
+	 * the thread that uses the parser and must not throw.
+	 *
+	 * The macro is defined with -DCPARSEPARSE_INSTRUMENTATION or by building with
+	 * @a make INSTRUMENTATION=1, and only decides whether the hooks are compiled
+	 * in: Argument_Parser has the same layout either way. Metrics are reported by
+	 * the hooks compiled into the code that runs, so the parse metrics come from
+	 * parse_args() as built for the program or the compiled library, and the
+	 * retrieval metrics from the translation units calling arg() and its
+	 * variants. Define it consistently to report both.
+	 */
+	class Parse_Observer {
+	public:
+		virtual ~Parse_Observer() = default;
+
+		/**
+		 * Called at the end of each call to Argument_Parser::parse_args(), including
+		 * calls that throw.
+		 */
+		virtual void parse_finished(const Parse_Metrics &) noexcept { }
+
+		/**
+		 * Called after each value is retrieved by Argument_Parser::arg(), arg_at()
+		 * or args().
+		 */
+		virtual void value_converted(const Conversion_Metrics &) noexcept { }
+	};
+
+	/**
+	 * Observer that accumulates the reported metrics and prints a summary.
+	 */
+	class Summary_Observer : public Parse_Observer {
+	public:
+		void parse_finished(const Parse_Metrics &metrics) noexcept override {
+			++m_parse_count;
+			if (metrics.failed)
+				++m_failed_count;
+			m_totals.match += metrics.match;
+			m_totals.assign += metrics.assign;
+			m_totals.total += metrics.total;
+			m_totals.token_count += metrics.token_count;
+			m_totals.value_count += metrics.value_count;
+			m_totals.allocation_count += metrics.allocation_count;
+			m_totals.allocated_bytes += metrics.allocated_bytes;
+		}
+
+		void value_converted(const Conversion_Metrics &metrics) noexcept override {
+			++m_conversion_count;
+			m_conversion_time += metrics.elapsed;
+		}
+
+		/**
+		 * @return the number of parses reported
+		 */
+		std::size_t parse_count() const noexcept {
+			return m_parse_count;
+		}
+
+		/**
+		 * @return the sum of the metrics of all reported parses
+		 */
+		const Parse_Metrics &totals() const noexcept {
+			return m_totals;
+		}
+
+		/**
+		 * @return the number of conversions reported
+		 */
+		std::size_t conversion_count() const noexcept {
+			return m_conversion_count;
+		}
+
+		/**
+		 * @return the total time spent in the reported conversions
+		 */
+		std::chrono::nanoseconds conversion_time() const noexcept {
+			return m_conversion_time;
+		}
+
+		/**
+		 * Print the totals and the averages per parse and per conversion.
+		 */
+		void print(std::ostream &out) const {
+			const auto parses = m_parse_count ? m_parse_count : 1;
+			const auto conversions = m_conversion_count ? m_conversion_count : 1;
+			const auto flags = out.flags();
+			const auto precision = out.precision();
+			out.setf(std::ios_base::fixed, std::ios_base::floatfield);
+			out.precision(1);
+			out << "parses:      " << m_parse_count << " (" << m_failed_count << " failed)\n"
+				<< "tokens:      " << m_totals.token_count << " (" << 1.0 * m_totals.token_count / parses << " per parse)\n"
+				<< "values:      " << m_totals.value_count << " (" << 1.0 * m_totals.value_count / parses << " per parse)\n"
+				<< "allocations: " << m_totals.allocation_count << " (" << m_totals.allocated_bytes << " bytes)\n";
+			print_phase(out, "match:       ", m_totals.match, parses);
+			print_phase(out, "assign:      ", m_totals.assign, parses);
+			print_phase(out, "total:       ", m_totals.total, parses);
+			out << "conversions: " << m_conversion_count << " in " << m_conversion_time.count() / 1000.0 << " us ("
+				<< 1.0 * m_conversion_time.count() / conversions << " ns per value)\n";
+			out.flags(flags);
+			out.precision(precision);
+		}
+
+	private:
+		Parse_Metrics m_totals{};
+		std::size_t m_parse_count{0};
+		std::size_t m_failed_count{0};
+		std::size_t m_conversion_count{0};
+		std::chrono::nanoseconds m_conversion_time{0};
+
+		static void print_phase(std::ostream &out, const char *label, std::chrono::nanoseconds elapsed, std::size_t parses) {
+			out << label << elapsed.count() / 1000.0 << " us (" << 1.0 * elapsed.count() / parses << " ns per parse)\n";
+		}
+	};
+
+	/**
+	 * Reports the time spent on a conversion when it goes out of scope.
+	 */
+	class _Conversion_Timer {
+	public:
+		_Conversion_Timer(Parse_Observer *observer, const std::string &name) noexcept
+				: m_observer{observer},
+				  m_name(name) {
+			if (m_observer)
+				m_start = Instrumentation_Clock::now();
+		}
+
+		~_Conversion_Timer() {
+			if (m_observer)
+				m_observer->value_converted(Conversion_Metrics{&m_name, Instrumentation_Clock::now() - m_start});
+		}
+
+		_Conversion_Timer(const _Conversion_Timer &) = delete;
+		_Conversion_Timer &operator=(const _Conversion_Timer &) = delete;
+
+	private:
+		Parse_Observer *m_observer;
+		const std::string &m_name;
+		Instrumentation_Clock::time_point m_start;
+	};
+
+}
+
+#endif /* CPARSEPARSE_INSTRUMENTATION_H_ */
@@ -9,8 +9,12 @@
 
 #include "cparseparse/argument-info.h"
 #include "cparseparse/util/compat.h"
+#include "cparseparse/util/memory-resource.h"
 #include "cparseparse/util/string-ops.h"
+#include "cparseparse/util/value-list.h"
 #include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <vector>
 
 namespace cpparse {
@@ -40,14 +44,16 @@ namespace cpparse {
 		/**
 		 * Construct optional argument info.
 		 *
-		 * @param name  argument name
-		 * @param type  optional argument type
+		 * @param name      argument name
+		 * @param type      optional argument type
+		 * @param resource  memory resource from which argument values are allocated
 		 */
 		template<class String>
-		explicit Optional_Info(String &&name, Type type) noexcept(noexcept(Argument_Info{std::forward<String>(name)}))
+		explicit Optional_Info(String &&name, Type type, Memory_Resource *resource = default_resource()) noexcept(noexcept(Argument_Info{std::forward<String>(name)}))
 				: Argument_Info{std::forward<String>(name)},
 				  m_flag{NO_FLAG},
-				  m_type{type} { }
+				  m_type{type},
+				  m_values{resource} { }
 
 		/**
 		 * Implicit conversion to bool.
@@ -79,6 +85,68 @@ namespace cpparse {
 			return m_type;
 		}
 
+		/**
+		 * @return the environment variable name set with env(), or an empty string if
+		 *         none was set
+		 */
+		const std::string &env() const noexcept {
+			return m_env;
+		}
+
+		/**
+		 * Set the environment variable from which Argument_Parser::load_environment()
+		 * reads the argument's value when it is not given on the command line.
+		 *
+		 * @tparam String  string-like type that is convertible to @a std::string
+		 * @param name     environment variable name
+		 * @return a reference to this object
+		 */
+		template<class String>
+		Optional_Info &env(String &&name) {
+			m_env = std::forward<String>(name);
+			return *this;
+		}
+
+		/**
+		 * @return true if the values are kept in compact storage, or false otherwise
+		 */
+		bool compact_storage() const noexcept {
+			return m_values.compact();
+		}
+
+		/**
+		 * Keep the values of this append-type argument in compact storage: a single
+		 * character buffer owned by the argument, plus a 4-byte offset per value.
+		 *
+		 * Each value otherwise takes a 16-byte view in addition to its characters in
+		 * the parser's value storage, so compact storage roughly halves the memory
+		 * held for long lists of short values. The values are always copied, even
+		 * with Options::zero_copy() or after seal(), and views of them obtained as
+		 * String_View remain valid until the next parse. Changing the setting clears
+		 * the argument's values.
+		 *
+		 * @param compact  whether to use compact storage
+		 * @return a reference to this object
+		 * @throw std::logic_error  If this is not an append-type argument.
+		 */
+		Optional_Info &compact_storage(bool compact) {
+			if (m_type != Type::APPEND)
+				throw std::logic_error{lerrstr("compact storage for '", m_name, "' requires an append-type argument")};
+			m_values.set_compact(compact);
+			m_cache.invalidate();
+			return *this;
+		}
+
+		/**
+		 * @return the number of bytes allocated by this argument for its values and
+		 *         cached conversions, excluding the characters of values held in the
+		 *         parser's value storage
+		 * @see Argument_Parser::arg_footprint()
+		 */
+		std::size_t memory_footprint() const noexcept {
+			return m_values.memory_footprint() + m_cache.memory_footprint();
+		}
+
 		/**
 		 * @return the number of values given for the argument.
 		 */
@@ -161,6 +229,10 @@ namespace cpparse {
 		 */
 		template<class T>
 		std::vector<T> as_type_all() const {
+			const auto p_cached = m_cache.find<T>();
+			if (p_cached)
+				return *p_cached;
+
 			std::vector<T> values;
 			values.reserve(count());
 			for (std::size_t i = 0; i < count(); ++i)
@@ -168,6 +240,112 @@ namespace cpparse {
 			return values;
 		}
 
+		/**
+		 * Convert all of the user-supplied values as type @a T and write them to the
+		 * given output iterator.
+		 *
+		 * Values are written in order until one cannot be parsed as type @a T, at
+		 * which point conversion stops without throwing. The returned result holds
+		 * the number of values written, which is also the index of the first invalid
+		 * value, along with the reason for the failure.
+		 *
+		 * @tparam T          type to parse arguments as
+		 * @tparam Output_It  output iterator type
+		 * @param out         output iterator to write values to
+		 * @return the number of values written and the conversion status
+		 */
+		template<class T, class Output_It>
+		Bulk_Convert_Result as_type_into(Output_It out) const {
+			return convert_values<T>(count(), out);
+		}
+
+		/**
+		 * Convert the user-supplied values as type @a T into the given buffer.
+		 *
+		 * At most @a size values are written. Conversion stops at the first value that
+		 * cannot be parsed as type @a T.
+		 *
+		 * @tparam T     type to parse arguments as
+		 * @param buffer buffer to write values to
+		 * @param size   number of values that fit in @a buffer
+		 * @return the number of values written and the conversion status
+		 * @see as_type_into(Output_It)
+		 */
+		template<class T>
+		Bulk_Convert_Result as_type_into(T *buffer, std::size_t size) const {
+			return convert_values<T>(std::min(size, count()), buffer);
+		}
+
+		/**
+		 * Convert all of the user-supplied values as type @a T once and cache the
+		 * results.
+		 *
+		 * Subsequent calls to as_type(), as_type_at() and as_type_all() with type @a T
+		 * return the cached values without parsing them again. The cache is cleared
+		 * by the next call to Argument_Parser::parse_args().
+		 *
+		 * @tparam T  type to parse arguments as
+		 * @return a reference to this object
+		 * @throw std::runtime_error  if any value cannot be parsed as type @a T
+		 */
+		template<class T>
+		Optional_Info &cache() {
+			m_cache.store<T>(count(), [this](std::size_t idx) { return parse_as_type<T>(m_values[idx]); });
+			return *this;
+		}
+
+		/**
+		 * Invoke a callback with each value of this append-type argument, parsed as
+		 * type @a T, as soon as it is matched.
+		 *
+		 * Values passed to the callback are not stored, so the application can
+		 * consume long lists while the remaining arguments are still being parsed
+		 * without a copy of the whole list being kept. Such values are not included
+		 * in exists() or count() and cannot be retrieved afterwards. If @a T is
+		 * String_View, the view is only valid during the call.
+		 *
+		 * The callback is invoked by both Argument_Parser::parse_args() and
+		 * Argument_Parser::parse(), and so must be safe to call concurrently if the
+		 * parser is shared between threads. Exceptions thrown by the callback abort
+		 * the parse. Values are passed on as soon as they are matched, before the
+		 * validators would run, so a callback cannot be combined with validator().
+		 *
+		 * @tparam T         type to parse each value as
+		 * @tparam Callable  callable type, invoked as @a callback(value)
+		 * @param callback   callable receiving each value
+		 * @return a reference to this object
+		 * @throw std::logic_error  If this is not an append-type argument, or it has
+		 *                          validators.
+		 */
+		template<class T, class Callable>
+		Optional_Info &on_value(Callable &&callback) {
+			if (m_type != Type::APPEND)
+				throw std::logic_error{lerrstr("value callback for '", m_name, "' requires an append-type argument")};
+			if (!m_validators.empty())
+				throw std::logic_error{lerrstr("value callback for '", m_name, "' cannot be combined with validators")};
+			typename std::decay<Callable>::type fn(std::forward<Callable>(callback));
+			const auto &converters = m_converters;
+			m_on_value = [fn, &converters](String_View value, const std::string &script_name, const std::string &name) mutable {
+				T result{};
+				const auto status = converters.convert<T>(value, result, name);
+				if (status != Convert_Status::OK)
+					throw std::runtime_error{cpparse::conversion_error<T>(script_name, name, status)};
+				fn(std::move(result));
+			};
+			return *this;
+		}
+
+		/**
+		 * @see Argument_Info::validator()
+		 * @throw std::logic_error  If this argument has a value callback.
+		 */
+		template<class Validator_Func>
+		Optional_Info &validator(Validator_Func &&validate) {
+			if (m_on_value)
+				throw std::logic_error{lerrstr("validator for '", m_name, "' cannot be combined with a value callback")};
+			return Argument_Info::validator(std::forward<Validator_Func>(validate));
+		}
+
 		/**
 		 * Print argument description.
 		 *
@@ -175,13 +353,32 @@ namespace cpparse {
 		 * @param out         output stream
 		 */
 		void print(std::size_t text_width, std::ostream &out = std::cout) const {
-			std::stringstream ss;
-			if (has_flag())
-				ss << "-" << m_flag << ", ";
-			ss << "--" << m_name;
-			if (m_type != Type::FLAG)
-				ss << " " << str_to_upper(m_name);
-			print_help(ss.str(), text_width, out);
+			std::string text;
+			render(text_width, text);
+			out << text;
+		}
+
+		/**
+		 * Append the argument description to the string.
+		 *
+		 * @param text_width  text width spacing
+		 * @param out         string to append to
+		 */
+		void render(std::size_t text_width, std::string &out) const {
+			const auto line_start = out.size();
+			out += "  ";
+			if (has_flag()) {
+				out += '-';
+				out += m_flag;
+				out += ", ";
+			}
+			out += "--";
+			out += m_name;
+			if (m_type != Type::FLAG) {
+				out += ' ';
+				append_upper(m_name, out);
+			}
+			render_help_text(line_start, text_width, out);
 		}
 
 	private:
@@ -192,7 +389,10 @@ namespace cpparse {
 
 		char m_flag;
 		Type m_type;
-		std::vector<std::string> m_values;
+		Value_List m_values;
+		std::function<void(String_View, const std::string &, const std::string &)> m_on_value;  // Set by on_value()
+		std::string m_env;
+		bool m_delivered{false};  // A value was passed to the callback by the last parse
 
 		/**
 		 * Retrieve the argument at the given index as a value of type @a T.
@@ -208,22 +408,47 @@ namespace cpparse {
 		 */
 		template<class T, bool has_default>
 		T as_type_at(std::size_t idx, T &&default_val) const {
-			if (exists())
-				return parse_as_type<T>(value(idx));
+			if (exists()) {
+				const auto p_cached = m_cache.find<T>();
+				return p_cached && idx < p_cached->size() ? (*p_cached)[idx] : parse_as_type<T>(value(idx));
+			}
 			IF_CONSTEXPR (has_default)
 				return std::forward<T>(default_val);
 			if (m_type == Type::FLAG)
 				return parse_as_type<T>("false");
+			if (m_on_value)
+				throw std::logic_error{lerrstr("values of '", m_name, "' are passed to its callback and not stored")};
 			throw std::logic_error{lerrstr("no value given for '", m_name, "' and no default specified")};
 		}
 
+		/**
+		 * Convert the first @a n values as type @a T and write them to the output
+		 * iterator, stopping at the first value that cannot be converted.
+		 */
+		template<class T, class Output_It>
+		Bulk_Convert_Result convert_values(std::size_t n, Output_It out) const {
+			const auto p_cached = m_cache.find<T>();
+			if (p_cached) {
+				std::copy_n(p_cached->begin(), n, out);
+				return Bulk_Convert_Result{n, Convert_Status::OK};
+			}
+			for (std::size_t i = 0; i < n; ++i) {
+				T value{};
+				const auto status = m_converters.convert<T>(m_values[i], value, m_name);
+				if (status != Convert_Status::OK)
+					return Bulk_Convert_Result{i, status};
+				*out++ = std::move(value);
+			}
+			return Bulk_Convert_Result{n, Convert_Status::OK};
+		}
+
 		/**
 		 * Retrieve the argument value at the given index.
 		 *
-		 * @return the argument value as a string
+		 * @return a view of the argument value
 		 * @throw std::out_of_range  if the index is out-of-range for the argument
 		 */
-		std::string value(std::size_t idx) const {
+		String_View value(std::size_t idx) const {
 			if (idx >= m_values.size())
 				throw std::out_of_range{lerrstr("index ", idx, " is out of range for '", m_name, "'")};
 			return m_values[idx];
@@ -241,12 +466,36 @@ namespace cpparse {
 		}
 
 		/**
-		 * Set the values for this optional argument.
+		 * Append a value for this optional argument.
 		 *
-		 * @param values  vector of values
+		 * @param value  value view
+		 */
+		void add_value(String_View value) {
+			m_values.push_back(value);
+		}
+
+		/**
+		 * Pass the value to the callback set by on_value(), if any.
+		 *
+		 * @param value        value view
+		 * @param script_name  script name prefixed to conversion errors
+		 * @return true if the value was passed to the callback, or false if it should
+		 *         be stored
+		 */
+		bool deliver_value(String_View value, const std::string &script_name) const {
+			if (!m_on_value)
+				return false;
+			m_on_value(value, script_name, m_name);
+			return true;
+		}
+
+		/**
+		 * Clear the values for this optional argument, keeping the allocated storage.
 		 */
-		void set_values(std::vector<std::string> &&values) noexcept(std::is_nothrow_move_assignable<std::vector<std::string>>::value) {
-			m_values = std::move(values);
+		void clear_values() noexcept {
+			m_values.clear();
+			m_delivered = false;
+			m_cache.invalidate();
 		}
 
 	};
@@ -0,0 +1,285 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_PARSE_RESULT_H_
+#define CPARSEPARSE_PARSE_RESULT_H_
+
+#include "cparseparse/argument-info.h"
+#include "cparseparse/util/compat.h"
+#include "cparseparse/util/convert.h"
+#include "cparseparse/util/errstr.h"
+#include "cparseparse/util/memory-resource.h"
+#include "cparseparse/util/string-view.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpparse {
+
+	class Argument_Parser;
+
+	/**
+	 * Values matched by a single call to Argument_Parser::parse().
+	 *
+	 * The result owns the matched values, so the parser that produced it is never
+	 * modified and can be shared between threads that parse concurrently. Values
+	 * are retrieved by name, in the same way as from the parser itself.
+	 *
+	 * The producing parser is used to look up argument names, so it must outlive
+	 * the result and must not be modified while the result is in use.
+	 */
+	class Parse_Result {
+	public:
+		using Values = std::vector<String_View, Resource_Allocator<String_View>>;
+
+		/**
+		 * @return the script name (argv[0]) given to the parse, which prefixes the
+		 *         conversion error messages
+		 */
+		const std::string &script_name() const noexcept {
+			return m_script_name;
+		}
+
+		/**
+		 * Determine whether the user has supplied a value for the specified optional
+		 * argument.
+		 *
+		 * @param name  optional argument reference name.
+		 * @return true if the value has been specified, or false otherwise.
+		 * @throw std::logic_error  If no optional argument with the specified name
+		 *                          exists.
+		 */
+		bool has_arg(const std::string &name) const {
+			return arg_count(name) != 0;
+		}
+
+		/**
+		 * Get the number of values provided for the specified optional argument.
+		 *
+		 * @param name  optional argument reference name.
+		 * @return The number of provided values.
+		 * @throw std::logic_error  If no optional argument with the specified name
+		 *                          exists.
+		 */
+		std::size_t arg_count(const std::string &name) const {
+			return lookup_optional(name).count;
+		}
+
+		/**
+		 * Retrieve the value of the user-supplied argument.
+		 *
+		 * @see Argument_Parser::arg()
+		 */
+		template<class T>
+		T arg(const std::string &name) const {
+			return arg_at<T>(name, 0);
+		}
+
+		/**
+		 * Retrieve the value of the possibly user-supplied argument, or the default
+		 * value if it was not supplied.
+		 *
+		 * @see Argument_Parser::arg()
+		 */
+		template<class T>
+		T arg(const std::string &name, T &&default_val) const {
+			return arg_at<T>(name, 0, std::forward<T>(default_val));
+		}
+
+		/**
+		 * Retrieve the value of the user-supplied argument at the specified index.
+		 *
+		 * @see Argument_Parser::arg_at()
+		 */
+		template<class T>
+		T arg_at(const std::string &name, std::size_t idx) const {
+			return arg_at<T, false>(name, idx, T{});
+		}
+
+		/**
+		 * Retrieve the value of the user-supplied argument at the specified index, or
+		 * the default value if it was not supplied.
+		 *
+		 * @see Argument_Parser::arg_at()
+		 */
+		template<class T>
+		T arg_at(const std::string &name, std::size_t idx, T &&default_val) const {
+			return arg_at<T, true>(name, idx, std::forward<T>(default_val));
+		}
+
+		/**
+		 * Retrieve the list of values that the user supplied for the given optional
+		 * argument.
+		 *
+		 * @see Argument_Parser::args()
+		 */
+		template<class T>
+		std::vector<T> args(const std::string &name) const {
+			const auto values = lookup_optional(name);
+			std::vector<T> result;
+			result.reserve(values.count);
+			for (std::size_t i = 0; i < values.count; ++i)
+				result.push_back(convert<T>(values, values.first[i]));
+			return result;
+		}
+
+		/**
+		 * Convert the list of values that the user supplied for the given optional
+		 * argument and write them to the output iterator, stopping without throwing
+		 * at the first value that cannot be parsed as type @a T.
+		 *
+		 * @see Argument_Parser::args_into()
+		 */
+		template<class T, class Output_It>
+		Bulk_Convert_Result args_into(const std::string &name, Output_It out) const {
+			const auto values = lookup_optional(name);
+			for (std::size_t i = 0; i < values.count; ++i) {
+				T value{};
+				const auto status = values.converters->convert<T>(values.first[i], value, *values.name);
+				if (status != Convert_Status::OK)
+					return Bulk_Convert_Result{i, status};
+				*out++ = std::move(value);
+			}
+			return Bulk_Convert_Result{values.count, Convert_Status::OK};
+		}
+
+		/**
+		 * @return the positional arguments beyond those registered, in order
+		 */
+		const Values &extra_args() const noexcept {
+			return m_extra_args;
+		}
+
+		/**
+		 * @return true if a subcommand was selected, or false otherwise.
+		 */
+		bool has_subcommand() const noexcept {
+			return m_subcommand != NO_INDEX;
+		}
+
+		/**
+		 * Retrieve the name of the selected subcommand.
+		 *
+		 * @return the subcommand name.
+		 * @throw std::logic_error  If no subcommand was selected.
+		 */
+		const std::string &subcommand() const;
+
+		/**
+		 * Number of command-line arguments from the subcommand name onwards, to be
+		 * parsed by the subcommand's own parser.
+		 *
+		 * Subcommand parsers are defined lazily by parse_args(), which would modify
+		 * the shared parser, so parse() stops at the subcommand name instead.
+		 *
+		 * @return the argument count, or 0 if no subcommand was selected
+		 */
+		int subcommand_argc() const noexcept {
+			return m_subcommand_argc;
+		}
+
+		/**
+		 * @return the command-line arguments from the subcommand name onwards, which
+		 *         refer directly to the argv given to the parse, or nullptr if no
+		 *         subcommand was selected or the arguments were read from a
+		 *         Token_Source, in which case the remaining tokens are left in the
+		 *         source
+		 * @see subcommand_argc()
+		 */
+		const char *const *subcommand_argv() const noexcept {
+			return m_subcommand_argv;
+		}
+
+	private:
+		friend class Argument_Parser;
+
+		/** Special constant to indicate that no subcommand was selected */
+		static constexpr std::size_t NO_INDEX{static_cast<std::size_t>(-1)};
+
+		/**
+		 * Values matched for a single argument.
+		 */
+		struct Arg_Values {
+			const std::string *name;
+			const Converter_Registry *converters;
+			const String_View *first;
+			std::size_t count;
+			bool flag;
+		};
+
+		const Argument_Parser *m_parser;
+		std::string m_script_name;
+		std::size_t m_positional_count{0};
+		Values m_values;  // Positional values, followed by the optional values grouped by argument
+		std::vector<std::size_t, Resource_Allocator<std::size_t>> m_offsets;  // Range of each optional argument's values
+		Values m_extra_args;
+		String_Arena m_storage;
+		std::size_t m_subcommand{NO_INDEX};
+		int m_subcommand_argc{0};
+		const char *const *m_subcommand_argv{nullptr};
+
+		Parse_Result(const Argument_Parser &parser, const char *script_name, Memory_Resource *resource)
+				: m_parser{&parser},
+				  m_script_name{script_name},
+				  m_values{Resource_Allocator<String_View>{resource}},
+				  m_offsets{Resource_Allocator<std::size_t>{resource}},
+				  m_extra_args{Resource_Allocator<String_View>{resource}},
+				  m_storage{resource} { }
+
+		/**
+		 * Look up the values of the positional or optional argument.
+		 *
+		 * @throw std::logic_error  If no argument with the specified name exists.
+		 */
+		Arg_Values lookup(const std::string &name) const;
+
+		/**
+		 * Look up the values of the optional argument.
+		 *
+		 * @throw std::logic_error  If no optional argument with the specified name
+		 *                          exists.
+		 */
+		Arg_Values lookup_optional(const std::string &name) const;
+
+		/**
+		 * Retrieve the value for the argument at the specified index with the given
+		 * default value.
+		 */
+		template<class T, bool has_default>
+		T arg_at(const std::string &name, std::size_t idx, T &&default_val) const;
+
+		/**
+		 * Parse the value as type @a T, reporting failures with this result's script
+		 * name.
+		 */
+		template<class T>
+		T convert(const Arg_Values &values, String_View value) const {
+			T result{};
+			const auto status = values.converters->convert<T>(value, result, *values.name);
+			if (status != Convert_Status::OK)
+				throw std::runtime_error{conversion_error<T>(m_script_name, *values.name, status)};
+			return result;
+		}
+	};
+
+	template<class T, bool has_default>
+	T Parse_Result::arg_at(const std::string &name, std::size_t idx, T &&default_val) const {
+		const auto values = lookup(name);
+		if (values.count) {
+			if (idx >= values.count)
+				throw std::out_of_range{lerrstr("index ", idx, " is out of range for '", *values.name, "'")};
+			return convert<T>(values, values.first[idx]);
+		}
+		IF_CONSTEXPR (has_default)
+			return std::forward<T>(default_val);
+		if (values.flag)
+			return convert<T>(values, "false");
+		throw std::logic_error{lerrstr("no value given for '", *values.name, "' and no default specified")};
+	}
+
+}
+
+#endif /* CPARSEPARSE_PARSE_RESULT_H_ */
@@ -0,0 +1,53 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_PARSE_STATUS_H_
+#define CPARSEPARSE_PARSE_STATUS_H_
+
+#include <cstddef>
+
+namespace cpparse {
+
+	/**
+	 * Reason that a command line was rejected.
+	 */
+	enum class Parse_Error {
+		NONE,                // The command line is valid
+		INVALID_FLAG,        // Unknown flag, e.g. '-z'
+		INVALID_OPTION,      // Unknown option, e.g. '--bogus'
+		MISSING_VALUE,       // An option that takes a value is not followed by one
+		REPEATED_ARGUMENT,   // A flag or single-value option is given more than once
+		MISSING_POSITIONAL,  // Fewer positional arguments than registered
+		INVALID_SUBCOMMAND,  // Unknown subcommand name
+		MISSING_SUBCOMMAND,  // Subcommands are defined but none was given
+		AMBIGUOUS_OPTION,    // Abbreviation of several options, e.g. '--ver' for '--verbose' and '--version'
+		UNEXPECTED_VALUE     // A value is attached to a flag, e.g. '--verbose=yes'
+	};
+
+	/**
+	 * Outcome of a non-throwing parse, e.g. Argument_Parser::validate().
+	 *
+	 * Holds only indices, so that rejecting a command line does not allocate. The
+	 * message reported by the throwing functions can be formatted on request with
+	 * Argument_Parser::error_message().
+	 */
+	struct Parse_Status {
+		Parse_Error error;
+		int index;             // Index in argv of the offending token, or argc if an argument is missing
+		std::size_t argument;  // Index of the optional (or, if missing, positional) argument concerned
+		const char *token;     // Offending token in argv, or nullptr if an argument is missing
+
+		/**
+		 * @return true if the command line is valid, or false otherwise
+		 */
+		explicit operator bool() const noexcept {
+			return error == Parse_Error::NONE;
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_PARSE_STATUS_H_ */
@@ -36,8 +36,35 @@ namespace cpparse {
 		 * @throw std::runtime_error  if the argument cannot be parsed as type @a T
 		 */
 		template<class T>
-		T as_type() const noexcept(noexcept(parse_as_type<T>(std::string{}))) {
-			return parse_as_type<T>(m_value);
+		T as_type() const noexcept(noexcept(parse_as_type<T>(String_View{}))) {
+			const auto p_cached = m_cache.find<T>();
+			return p_cached && !p_cached->empty() ? p_cached->front() : parse_as_type<T>(m_value);
+		}
+
+		/**
+		 * Convert the argument as type @a T once and cache the result.
+		 *
+		 * Subsequent calls to as_type() with type @a T return the cached value without
+		 * parsing it again. The cache is cleared by the next call to
+		 * Argument_Parser::parse_args().
+		 *
+		 * @tparam T  type to parse the argument as
+		 * @return a reference to this object
+		 * @throw std::runtime_error  if the argument cannot be parsed as type @a T
+		 */
+		template<class T>
+		Positional_Info &cache() {
+			m_cache.store<T>(1, [this](std::size_t) { return parse_as_type<T>(m_value); });
+			return *this;
+		}
+
+		/**
+		 * @return the number of bytes allocated by this argument for cached
+		 *         conversions of its value
+		 * @see Argument_Parser::arg_footprint()
+		 */
+		std::size_t memory_footprint() const noexcept {
+			return m_cache.memory_footprint();
 		}
 
 		/**
@@ -47,19 +74,35 @@ namespace cpparse {
 		 * @param out         output stream
 		 */
 		void print(std::size_t text_width, std::ostream &out = std::cout) const {
-			print_help(text_width, out);
+			std::string text;
+			render(text_width, text);
+			out << text;
+		}
+
+		/**
+		 * Append the argument description to the string.
+		 *
+		 * @param text_width  text width spacing
+		 * @param out         string to append to
+		 */
+		void render(std::size_t text_width, std::string &out) const {
+			const auto line_start = out.size();
+			out += "  ";
+			out += m_name;
+			render_help_text(line_start, text_width, out);
 		}
 
 	private:
 		friend class Argument_Parser;
 
-		std::string m_value;
+		String_View m_value;
 
 		/* Private functions for Argument_Parser */
 
 		template<class String>
 		void set_value(String &&value) noexcept(std::is_nothrow_assignable<decltype(m_value), String &&>::value) {
 			m_value = std::forward<String>(value);
+			m_cache.invalidate();
 		}
 
 	};
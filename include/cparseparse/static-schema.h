@@ -0,0 +1,217 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_STATIC_SCHEMA_H_
+#define CPARSEPARSE_STATIC_SCHEMA_H_
+
+#include "cparseparse/optional-info.h"
+#include "cparseparse/util/option-names.h"
+#include "cparseparse/util/string-view.h"
+#include <cstddef>
+#include <stdexcept>
+
+namespace cpparse {
+
+	/**
+	 * Compile-time helpers for the static schema.
+	 *
+	 * These mirror the runtime name checks in option-names.h using single-expression
+	 * recursion so that they can be evaluated in C++11 constant expressions.
+	 */
+	constexpr bool _static_name_chars(const char *name) noexcept {
+		return !*name || (is_name_char(*name) && _static_name_chars(name + 1));
+	}
+
+	constexpr bool _static_positional_name(const char *name) noexcept {
+		return (is_name_start_char(*name) || ('0' <= *name && *name <= '9')) && _static_name_chars(name + 1);
+	}
+
+	constexpr const char *_static_long_name_begin(const char *name) noexcept {
+		return name + (name[1] == '-' ? 2 : 1);
+	}
+
+	constexpr bool _static_long_name(const char *name) noexcept {
+		return name[0] == '-' && is_name_start_char(_static_long_name_begin(name)[0])
+				&& _static_long_name_begin(name)[1] && _static_name_chars(_static_long_name_begin(name) + 1);
+	}
+
+	constexpr bool _static_flag_name(const char *name) noexcept {
+		return name[0] == '-' && is_name_start_char(name[1]) && !name[2];
+	}
+
+	constexpr std::size_t _static_strlen(const char *str) noexcept {
+		return *str ? 1 + _static_strlen(str + 1) : 0;
+	}
+
+	constexpr bool _static_streq(const char *lhs, const char *rhs) noexcept {
+		return *lhs == *rhs && (!*lhs || _static_streq(lhs + 1, rhs + 1));
+	}
+
+	/**
+	 * Argument definition that is validated when it is constructed, at compile time
+	 * when used in a constant expression.
+	 *
+	 * Constructed with static_positional() and static_optional().
+	 */
+	struct Static_Argument {
+		enum class Kind { POSITIONAL, OPTIONAL };
+
+		Kind kind;
+		const char *name;        // Reference name (without leading dashes)
+		std::size_t name_size;
+		std::size_t hash;        // String_View_Hash of the reference name
+		char flag;               // Flag character, or 0 if none
+		Optional_Info::Type type;
+	};
+
+	/**
+	 * Define a positional argument for a static schema.
+	 *
+	 * @param name  positional argument name
+	 * @return the argument definition
+	 * @throw std::logic_error  If @a name is not in the correct format. In a
+	 *                          constant expression, this is a compile-time error.
+	 */
+	constexpr Static_Argument static_positional(const char *name) {
+		return _static_positional_name(name)
+				? Static_Argument{Static_Argument::Kind::POSITIONAL, name, _static_strlen(name), String_View_Hash::hash(name), 0, Optional_Info::Type::SINGLE}
+				: throw std::logic_error{"invalid positional argument name"};
+	}
+
+	/**
+	 * Define an optional argument with the given "long" name and type for a static
+	 * schema.
+	 *
+	 * @param long_name  argument "long" name (starts with @p '-' or @p '--'
+	 *                   followed by a non-digit character)
+	 * @param type       optional argument type
+	 * @return the argument definition
+	 * @throw std::logic_error  If @a long_name is not in the correct format. In a
+	 *                          constant expression, this is a compile-time error.
+	 */
+	constexpr Static_Argument static_optional(const char *long_name, Optional_Info::Type type = Optional_Info::Type::SINGLE) {
+		return _static_long_name(long_name)
+				? Static_Argument{Static_Argument::Kind::OPTIONAL, _static_long_name_begin(long_name), _static_strlen(_static_long_name_begin(long_name)),
+						String_View_Hash::hash(_static_long_name_begin(long_name)), 0, type}
+				: throw std::logic_error{"invalid optional argument name"};
+	}
+
+	/**
+	 * Define an optional argument with the given flag name, "long" name, and type
+	 * for a static schema.
+	 *
+	 * @param flag       flag name (@p '-' followed by a single non-digit character)
+	 * @param long_name  argument "long" name (starts with @p '-' or @p '--'
+	 *                   followed by a non-digit character)
+	 * @param type       optional argument type
+	 * @return the argument definition
+	 * @throw std::logic_error  If either @a flag or @a long_name are not in the
+	 *                          correct format. In a constant expression, this is a
+	 *                          compile-time error.
+	 */
+	constexpr Static_Argument static_optional(const char *flag, const char *long_name, Optional_Info::Type type = Optional_Info::Type::SINGLE) {
+		return _static_flag_name(flag)
+				? Static_Argument{Static_Argument::Kind::OPTIONAL, static_optional(long_name, type).name, static_optional(long_name, type).name_size,
+						static_optional(long_name, type).hash, flag[1], type}
+				: throw std::logic_error{"invalid flag name"};
+	}
+
+	/**
+	 * Fixed set of argument definitions whose names are validated and hashed at
+	 * compile time.
+	 *
+	 * Construct with make_static_schema() and pass to the Argument_Parser schema
+	 * constructor. Declaring the schema @a constexpr turns invalid, duplicate or
+	 * conflicting names into compile-time errors.
+	 */
+	template<std::size_t N>
+	class Static_Schema {
+		static_assert(N > 0, "static schema requires at least one argument");
+	public:
+
+		template<class ...Args>
+		constexpr explicit Static_Schema(const Static_Argument &first, const Args &...rest) noexcept
+				: m_args{first, rest...} { }
+
+		constexpr std::size_t size() const noexcept {
+			return N;
+		}
+
+		constexpr const Static_Argument &operator[](std::size_t idx) const noexcept {
+			return m_args[idx];
+		}
+
+		constexpr const Static_Argument *begin() const noexcept {
+			return m_args;
+		}
+
+		constexpr const Static_Argument *end() const noexcept {
+			return m_args + N;
+		}
+
+		/**
+		 * Look up an argument by reference name.
+		 *
+		 * @param name  argument reference name
+		 * @return the index of the argument, or size() if no argument has that name
+		 */
+		constexpr std::size_t index_of(const char *name) const noexcept {
+			return index_of(name, String_View_Hash::hash(name), 0);
+		}
+
+		/**
+		 * Check the definitions for duplicate and conflicting names.
+		 *
+		 * @return true
+		 * @throw std::logic_error  If two arguments share a name or a flag.
+		 */
+		constexpr bool validate() const {
+			return validate_from(0);
+		}
+
+	private:
+		Static_Argument m_args[N];
+
+		constexpr std::size_t index_of(const char *name, std::size_t hash, std::size_t idx) const noexcept {
+			return idx == N || (m_args[idx].hash == hash && _static_streq(m_args[idx].name, name)) ? idx : index_of(name, hash, idx + 1);
+		}
+
+		constexpr bool validate_from(std::size_t idx) const {
+			return idx == N || (validate_pairs(idx, idx + 1) && validate_from(idx + 1));
+		}
+
+		constexpr bool validate_pairs(std::size_t idx, std::size_t other) const {
+			return other == N || (validate_pair(m_args[idx], m_args[other]) && validate_pairs(idx, other + 1));
+		}
+
+		static constexpr bool validate_pair(const Static_Argument &lhs, const Static_Argument &rhs) {
+			return !(lhs.hash == rhs.hash && _static_streq(lhs.name, rhs.name))
+					? (!lhs.flag || lhs.flag != rhs.flag ? true : throw std::logic_error{"duplicate flag name"})
+					: throw std::logic_error{lhs.kind == rhs.kind ? "duplicate argument name" : "argument name conflicts between positional and optional arguments"};
+		}
+	};
+
+	template<std::size_t N>
+	constexpr Static_Schema<N> _validated(const Static_Schema<N> &schema) {
+		return static_cast<void>(schema.validate()), schema;
+	}
+
+	/**
+	 * Create a validated static schema from the given argument definitions.
+	 *
+	 * @param args  definitions created by static_positional() and static_optional()
+	 * @return the schema
+	 * @throw std::logic_error  If two arguments share a name or a flag. In a
+	 *                          constant expression, this is a compile-time error.
+	 */
+	template<class ...Args>
+	constexpr Static_Schema<sizeof...(Args)> make_static_schema(const Args &...args) {
+		return _validated(Static_Schema<sizeof...(Args)>{args...});
+	}
+
+}
+
+#endif /* CPARSEPARSE_STATIC_SCHEMA_H_ */
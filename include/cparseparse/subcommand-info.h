@@ -0,0 +1,73 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_SUBCOMMAND_INFO_H_
+#define CPARSEPARSE_SUBCOMMAND_INFO_H_
+
+#include "cparseparse/argument-info.h"
+#include <functional>
+
+namespace cpparse {
+
+	class Argument_Parser;
+
+	/**
+	 * Subcommand info object storing information about a subcommand.
+	 *
+	 * Provides functions for setting additional subcommand properties.
+	 */
+	class Subcommand_Info : public Argument_Info<Subcommand_Info> {
+	public:
+
+		/** Callable that defines the arguments of the subcommand's parser */
+		using Factory = std::function<void(Argument_Parser &)>;
+
+		/**
+		 * Construct subcommand info.
+		 *
+		 * @param name     subcommand name
+		 * @param factory  callable that defines the subcommand's arguments
+		 */
+		template<class String>
+		Subcommand_Info(String &&name, Factory factory)
+				: Argument_Info{std::forward<String>(name)},
+				  m_factory{std::move(factory)} { }
+
+		/**
+		 * Print subcommand description.
+		 *
+		 * @param text_width  text width spacing
+		 * @param out         output stream
+		 */
+		void print(std::size_t text_width, std::ostream &out = std::cout) const {
+			std::string text;
+			render(text_width, text);
+			out << text;
+		}
+
+		/**
+		 * Append the subcommand description to the string.
+		 *
+		 * @param text_width  text width spacing
+		 * @param out         string to append to
+		 */
+		void render(std::size_t text_width, std::string &out) const {
+			const auto line_start = out.size();
+			out += "  ";
+			out += m_name;
+			render_help_text(line_start, text_width, out);
+		}
+
+	private:
+		friend class Argument_Parser;
+
+		Factory m_factory;
+
+	};
+
+}
+
+#endif /* CPARSEPARSE_SUBCOMMAND_INFO_H_ */
@@ -0,0 +1,253 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_TOKEN_SOURCE_H_
+#define CPARSEPARSE_TOKEN_SOURCE_H_
+
+#include "cparseparse/util/compat.h"
+#include "cparseparse/util/mapped-file.h"
+#include <cctype>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Source of command-line tokens consumed one at a time by
+	 * Argument_Parser::parse().
+	 *
+	 * Allows a parser to read arguments that were never collected into an argv
+	 * array, e.g. from a file or pipe holding more arguments than the system allows
+	 * on a command line.
+	 */
+	class Token_Source {
+	public:
+		virtual ~Token_Source() = default;
+
+		/**
+		 * Read the next token.
+		 *
+		 * @return the null-terminated token, which remains valid until the next call,
+		 *         or nullptr once the source is exhausted
+		 */
+		const char *next() {
+			return do_next();
+		}
+
+	private:
+		virtual const char *do_next() = 0;
+	};
+
+	/**
+	 * Token source reading the strings of an argv array, excluding the script name
+	 * in @a argv[0].
+	 */
+	class Argv_Source : public Token_Source {
+	public:
+		Argv_Source(int argc, const char *const *argv) noexcept
+				: m_argc{argc},
+				  m_argv{argv} { }
+
+	private:
+		int m_argc;
+		const char *const *m_argv;
+		int m_pos{1};
+
+		const char *do_next() override {
+			return m_pos < m_argc ? m_argv[m_pos++] : nullptr;
+		}
+	};
+
+	inline const char *_token_c_str(const char *token) noexcept {
+		return token;
+	}
+
+	inline const char *_token_c_str(const std::string &token) noexcept {
+		return token.c_str();
+	}
+
+	/**
+	 * Token source reading a range of strings (@a std::string or @a const char *).
+	 *
+	 * The iterator is only advanced when the following token is requested, so
+	 * single-pass iterators such as @a std::istream_iterator can be used.
+	 */
+	template<class Input_It>
+	class Iterator_Source : public Token_Source {
+	public:
+		Iterator_Source(Input_It first, Input_It last)
+				: m_it{std::move(first)},
+				  m_end{std::move(last)} { }
+
+	private:
+		Input_It m_it;
+		Input_It m_end;
+		bool m_started{false};
+
+		const char *do_next() override {
+			if (m_started && m_it != m_end)
+				++m_it;
+			m_started = true;
+			return m_it != m_end ? _token_c_str(*m_it) : nullptr;
+		}
+	};
+
+	/**
+	 * Create a token source reading the strings in [@a first, @a last).
+	 */
+	template<class Input_It>
+	Iterator_Source<Input_It> make_token_source(Input_It first, Input_It last) {
+		return Iterator_Source<Input_It>{std::move(first), std::move(last)};
+	}
+
+	/**
+	 * Read the next token from the characters returned by @a next_char.
+	 *
+	 * Tokens are separated by whitespace. Within a token, whitespace enclosed in
+	 * single or double quotes is kept. Characters in single quotes are taken
+	 * literally, while elsewhere a backslash takes the following character
+	 * literally. An unterminated quote ends at the end of the input.
+	 *
+	 * @param next_char  callable returning the next character as an @a int, or
+	 *                   @a std::char_traits<char>::eof() at the end of the input
+	 * @param token      string to store the token in
+	 * @return true if a token was read, or false at the end of the input
+	 */
+	template<class Next_Char>
+	bool _read_token(Next_Char &&next_char, std::string &token) {
+		const auto eof = std::char_traits<char>::eof();
+		token.clear();
+		auto c = next_char();
+		while (c != eof && std::isspace(c))
+			c = next_char();
+		if (c == eof)
+			return false;
+
+		int quote{0};
+		for (; c != eof; c = next_char()) {
+			if (c == quote) {
+				quote = 0;
+			} else if (c == '\\' && quote != '\'') {
+				c = next_char();
+				if (c == eof)
+					break;
+				token += static_cast<char>(c);
+			} else if (!quote && (c == '\'' || c == '"')) {
+				quote = c;
+			} else if (!quote && std::isspace(c)) {
+				break;
+			} else {
+				token += static_cast<char>(c);
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Token source reading whitespace-separated tokens from an input stream, e.g.
+	 * standard input connected to a pipe.
+	 *
+	 * @see _read_token() for the quoting rules
+	 */
+	class Stream_Source : public Token_Source {
+	public:
+		explicit Stream_Source(std::istream &in) noexcept
+				: m_in{in} { }
+
+	private:
+		std::istream &m_in;
+		std::string m_token;
+
+		const char *do_next() override {
+			const auto buf = m_in.rdbuf();
+			if (!buf)
+				return nullptr;
+			return _read_token([buf] { return buf->sbumpc(); }, m_token) ? m_token.c_str() : nullptr;
+		}
+	};
+
+	/**
+	 * Token source reading whitespace-separated tokens from a memory-mapped file.
+	 *
+	 * @see _read_token() for the quoting rules
+	 */
+	class File_Source : public Token_Source {
+	public:
+
+		/**
+		 * @param path  file path
+		 * @throw std::runtime_error  If the file cannot be opened.
+		 */
+		explicit File_Source(const std::string &path)
+				: m_file{path},
+				  m_pos{m_file.data()},
+				  m_end{m_file.data() + m_file.size()} { }
+
+	private:
+		Mapped_File m_file;
+		const char *m_pos;
+		const char *m_end;
+		std::string m_token;
+
+		const char *do_next() override {
+			const auto next_char = [this]() -> int {
+				return m_pos != m_end ? static_cast<unsigned char>(*m_pos++) : std::char_traits<char>::eof();
+			};
+			return _read_token(next_char, m_token) ? m_token.c_str() : nullptr;
+		}
+	};
+
+	/**
+	 * Token source that expands @a \@file tokens read from another source into the
+	 * tokens of the named response file.
+	 *
+	 * Response files may themselves refer to other response files, up to a
+	 * nesting depth of MAX_DEPTH.
+	 */
+	class Response_File_Source : public Token_Source {
+	public:
+
+		/** Maximum nesting depth of response files */
+		static constexpr std::size_t MAX_DEPTH{16};
+
+		/**
+		 * @param source  source of the tokens to expand, which must outlive this one
+		 */
+		explicit Response_File_Source(Token_Source &source) noexcept
+				: m_source{source} { }
+
+	private:
+		Token_Source &m_source;
+		std::vector<std::unique_ptr<File_Source>> m_files;
+
+		/**
+		 * @throw std::runtime_error  If a response file cannot be opened or they are
+		 *                            nested too deeply.
+		 */
+		const char *do_next() override {
+			for (;;) {
+				const auto token = m_files.empty() ? m_source.next() : m_files.back()->next();
+				if (!token) {
+					if (m_files.empty())
+						return nullptr;
+					m_files.pop_back();
+					continue;
+				}
+				if (token[0] != '@' || !token[1])
+					return token;
+				if (m_files.size() == MAX_DEPTH)
+					throw std::runtime_error{std::string{"response file '"} + (token + 1) + "' is nested too deeply"};
+				m_files.push_back(make_unique<File_Source>(token + 1));
+			}
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_TOKEN_SOURCE_H_ */
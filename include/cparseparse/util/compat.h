@@ -27,6 +27,16 @@ namespace cpparse {
 #else
 #define IF_CONSTEXPR if
 #endif /* __cplusplus >= 201703L */
+
+/*
+ * Functions defined out of line are inline in the default header-only build, and
+ * compiled once into the cparseparse library if CPARSEPARSE_LIBRARY is defined.
+ */
+#ifdef CPARSEPARSE_LIBRARY
+#define CPARSEPARSE_INLINE
+#else
+#define CPARSEPARSE_INLINE inline
+#endif /* CPARSEPARSE_LIBRARY */
 }
 
 #endif /* CPARSEPARSE_UTIL_COMPAT_H_ */
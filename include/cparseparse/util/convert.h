@@ -0,0 +1,248 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_CONVERT_H_
+#define CPARSEPARSE_UTIL_CONVERT_H_
+
+#include "cparseparse/util/string-view.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#define CPARSEPARSE_HAS_FROM_CHARS 1
+#endif /* __has_include(<charconv>) */
+#endif /* __cplusplus >= 201703L && defined(__has_include) */
+
+#if defined(CPARSEPARSE_HAS_FROM_CHARS) && defined(__cpp_lib_to_chars)
+#define CPARSEPARSE_HAS_FLOAT_FROM_CHARS 1
+#endif /* defined(CPARSEPARSE_HAS_FROM_CHARS) && defined(__cpp_lib_to_chars) */
+
+namespace cpparse {
+
+	/**
+	 * Result of a value conversion.
+	 *
+	 * OK            the value was converted successfully
+	 *
+	 * INVALID       the value is not in the format required by the type
+	 *
+	 * OUT_OF_RANGE  the value is numeric but cannot be represented by the type
+	 */
+	enum class Convert_Status { OK, INVALID, OUT_OF_RANGE };
+
+	/**
+	 * Result of converting a list of values.
+	 */
+	struct Bulk_Convert_Result {
+		std::size_t count;      // Number of values converted and written
+		Convert_Status status;  // OK, or the status of the value at index @a count
+
+		/**
+		 * @return true if every value was converted, or false otherwise
+		 */
+		explicit operator bool() const noexcept {
+			return status == Convert_Status::OK;
+		}
+	};
+
+	/**
+	 * Helpers for convert_value().
+	 */
+	inline bool _is_space(char c) noexcept {
+		return c == ' ' || ('\t' <= c && c <= '\r');
+	}
+
+	inline const char *_skip_space(const char *first, const char *last) noexcept {
+		while (first != last && _is_space(*first))
+			++first;
+		return first;
+	}
+
+	/**
+	 * Parse a base-10 magnitude from the start of the range, accumulating into @a out.
+	 *
+	 * Trailing characters after the digits are ignored.
+	 */
+	inline Convert_Status _parse_magnitude(const char *first, const char *last, unsigned long long &out) noexcept {
+#ifdef CPARSEPARSE_HAS_FROM_CHARS
+		const auto result = std::from_chars(first, last, out);
+		if (result.ec == std::errc::result_out_of_range)
+			return Convert_Status::OUT_OF_RANGE;
+		return result.ec == std::errc{} ? Convert_Status::OK : Convert_Status::INVALID;
+#else
+		if (first == last || !('0' <= *first && *first <= '9'))
+			return Convert_Status::INVALID;
+		constexpr auto max_prefix = std::numeric_limits<unsigned long long>::max() / 10;
+		constexpr auto max_last_digit = std::numeric_limits<unsigned long long>::max() % 10;
+		out = 0;
+		for (; first != last && '0' <= *first && *first <= '9'; ++first) {
+			const unsigned digit = *first - '0';
+			if (out > max_prefix || (out == max_prefix && digit > max_last_digit))
+				return Convert_Status::OUT_OF_RANGE;
+			out = out * 10 + digit;
+		}
+		return Convert_Status::OK;
+#endif /* CPARSEPARSE_HAS_FROM_CHARS */
+	}
+
+#ifndef CPARSEPARSE_HAS_FLOAT_FROM_CHARS
+	inline Convert_Status _strtold(const char *str, long double &out) noexcept {
+		const auto saved_errno = errno;
+		errno = 0;
+		char *p_end;
+		out = std::strtold(str, &p_end);
+		const auto status = p_end == str ? Convert_Status::INVALID : errno == ERANGE ? Convert_Status::OUT_OF_RANGE : Convert_Status::OK;
+		errno = saved_errno;
+		return status;
+	}
+
+	inline Convert_Status _parse_floating_long(const char *first, const char *last, long double &out) noexcept {
+		try {
+			return _strtold(std::string(first, last).c_str(), out);
+		} catch (const std::bad_alloc &) {
+			return Convert_Status::INVALID;
+		}
+	}
+#endif /* CPARSEPARSE_HAS_FLOAT_FROM_CHARS */
+
+	/**
+	 * Parse a long double from the start of the range.
+	 *
+	 * Trailing characters after the number are ignored.
+	 */
+	inline Convert_Status _parse_floating(const char *first, const char *last, long double &out) noexcept {
+#ifdef CPARSEPARSE_HAS_FLOAT_FROM_CHARS
+		const bool negative = first != last && *first == '-';
+		if (first != last && (*first == '-' || *first == '+'))
+			++first;
+		if (first != last && *first == '-')
+			return Convert_Status::INVALID;
+		auto format = std::chars_format::general;
+		if (last - first > 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+			first += 2;
+			format = std::chars_format::hex;
+		}
+		const auto result = std::from_chars(first, last, out, format);
+		if (result.ec == std::errc::result_out_of_range)
+			return Convert_Status::OUT_OF_RANGE;
+		if (result.ec != std::errc{})
+			return Convert_Status::INVALID;
+		if (negative)
+			out = -out;
+		return Convert_Status::OK;
+#else
+		/* strtold() requires a null-terminated string */
+		char buffer[64];
+		const std::size_t size = last - first;
+		if (size >= sizeof(buffer))
+			return _parse_floating_long(first, last, out);
+		std::copy(first, last, buffer);
+		buffer[size] = '\0';
+		return _strtold(buffer, out);
+#endif /* CPARSEPARSE_HAS_FLOAT_FROM_CHARS */
+	}
+
+	/**
+	 * Convert the string to a value of type @a T without throwing.
+	 *
+	 * Numeric conversions follow the @a std::stoll/@a std::stold conventions:
+	 * leading whitespace and a sign are accepted, and any characters following the
+	 * number are ignored. Unsigned types reject negative values as out of range.
+	 *
+	 * @tparam T     type to convert the value to
+	 * @param value  the value as a string
+	 * @param out    converted value; only modified on success
+	 * @return the conversion status
+	 */
+	template<class T>
+	typename std::enable_if<std::is_same<T, bool>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		if (value == "true" || value == "yes" || value == "on")
+			out = true;
+		else if (value == "false" || value == "no" || value == "off")
+			out = false;
+		else
+			return Convert_Status::INVALID;
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<std::is_same<T, char>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		if (value.size() != 1)
+			return Convert_Status::INVALID;
+		out = value[0];
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<!std::is_same<T, bool>::value && std::is_integral<T>::value && std::is_unsigned<T>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		const auto last = value.data() + value.size();
+		auto first = _skip_space(value.data(), last);
+		if (first != last && *first == '-')
+			return Convert_Status::OUT_OF_RANGE;
+		if (first != last && *first == '+')
+			++first;
+		unsigned long long magnitude;
+		const auto status = _parse_magnitude(first, last, magnitude);
+		if (status != Convert_Status::OK)
+			return status;
+		if (magnitude > std::numeric_limits<T>::max())
+			return Convert_Status::OUT_OF_RANGE;
+		out = static_cast<T>(magnitude);
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<!std::is_same<T, char>::value && std::is_integral<T>::value && std::is_signed<T>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		const auto last = value.data() + value.size();
+		auto first = _skip_space(value.data(), last);
+		const bool negative = first != last && *first == '-';
+		if (first != last && (*first == '-' || *first == '+'))
+			++first;
+		unsigned long long magnitude;
+		const auto status = _parse_magnitude(first, last, magnitude);
+		if (status != Convert_Status::OK)
+			return status;
+		const auto limit = negative
+				? static_cast<unsigned long long>(-(std::numeric_limits<T>::min() + 1)) + 1
+				: static_cast<unsigned long long>(std::numeric_limits<T>::max());
+		if (magnitude > limit)
+			return Convert_Status::OUT_OF_RANGE;
+		if (negative && magnitude)
+			out = static_cast<T>(-static_cast<long long>(magnitude - 1) - 1);
+		else
+			out = static_cast<T>(magnitude);
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<std::is_floating_point<T>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		long double n_value;
+		const auto last = value.data() + value.size();
+		const auto status = _parse_floating(_skip_space(value.data(), last), last, n_value);
+		if (status != Convert_Status::OK)
+			return status;
+		if (n_value < std::numeric_limits<T>::lowest() || n_value > std::numeric_limits<T>::max())
+			return Convert_Status::OUT_OF_RANGE;
+		out = static_cast<T>(n_value);
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<std::is_same<T, std::string>::value, Convert_Status>::type convert_value(String_View value, T &out) {
+		out.assign(value.data(), value.size());
+		return Convert_Status::OK;
+	}
+	template<class T>
+	typename std::enable_if<std::is_same<T, String_View>::value, Convert_Status>::type convert_value(String_View value, T &out) noexcept {
+		out = value;
+		return Convert_Status::OK;
+	}
+
+}
+
+#endif /* CPARSEPARSE_UTIL_CONVERT_H_ */
@@ -7,32 +7,50 @@
 #ifndef CPARSEPARSE_UTIL_ERRSTR_H_
 #define CPARSEPARSE_UTIL_ERRSTR_H_
 
-#include <sstream>
+#include "cparseparse/util/string-view.h"
+#include <cstdio>
 #include <string>
+#include <type_traits>
 
 namespace cpparse {
 
-	std::string _scriptname;
-
 	/**
-	 * Set script name for error print-outs.
+	 * Append a word to an error string, formatted as an output stream would.
+	 *
+	 * Error strings are built by appending to a @a std::string rather than with a
+	 * string stream, so that @a <sstream> is not part of the public interface.
 	 */
-	template<class String_Ref>
-	void errstr_set_script_name(String_Ref &&name) {
-		_scriptname = std::forward<String_Ref>(name);
+	inline void _errstr_append(std::string &out, const char *str) {
+		out += str;
+	}
+	inline void _errstr_append(std::string &out, const std::string &str) {
+		out += str;
+	}
+	inline void _errstr_append(std::string &out, String_View str) {
+		out.append(str.data(), str.size());
+	}
+	inline void _errstr_append(std::string &out, char c) {
+		out += c;
+	}
+	template<class T>
+	typename std::enable_if<std::is_integral<T>::value>::type _errstr_append(std::string &out, T value) {
+		out += std::to_string(value);
+	}
+	template<class T>
+	typename std::enable_if<std::is_floating_point<T>::value>::type _errstr_append(std::string &out, T value) {
+		char buffer[32];
+		const auto size = std::snprintf(buffer, sizeof(buffer), "%Lg", static_cast<long double>(value));
+		out.append(buffer, size);
 	}
 
 	/**
-	 * Recursive helpers for errstr()/lerrstr().
+	 * Recursive helpers for lerrstr()/script_errstr().
 	 */
-	template<class Arg>
-	void _errstr(std::stringstream &ss, Arg &&arg) {
-		ss << std::forward<Arg>(arg);
-	}
+	inline void _errstr(std::string &) { }
 	template<class Arg, class ...Args>
-	void _errstr(std::stringstream &ss, Arg &&arg, Args&&... args) {
-		_errstr(ss, std::forward<Arg>(arg));
-		_errstr(ss, std::forward<Args>(args)...);
+	void _errstr(std::string &out, Arg &&arg, Args&&... args) {
+		_errstr_append(out, std::forward<Arg>(arg));
+		_errstr(out, std::forward<Args>(args)...);
 	}
 
 	/**
@@ -40,19 +58,20 @@ namespace cpparse {
 	 */
 	template<class ...Args>
 	std::string lerrstr(Args&&... args) {
-		std::stringstream ss;
-		_errstr(ss, "Argument_Parser: ", std::forward<Args>(args)...);
-		return ss.str();
+		std::string str;
+		_errstr(str, "Argument_Parser: ", std::forward<Args>(args)...);
+		return str;
 	}
 
 	/**
-	 * Concatenate words into a runtime error string.
+	 * Concatenate words into a runtime error string prefixed with the given script
+	 * name.
 	 */
 	template<class ...Args>
-	std::string errstr(Args&&... args) {
-		std::stringstream ss;
-		_errstr(ss, _scriptname, ": ", std::forward<Args>(args)...);
-		return ss.str();
+	std::string script_errstr(const std::string &script_name, Args&&... args) {
+		std::string str;
+		_errstr(str, script_name, ": ", std::forward<Args>(args)...);
+		return str;
 	}
 
 }
@@ -0,0 +1,137 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_MAPPED_FILE_H_
+#define CPARSEPARSE_UTIL_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CPARSEPARSE_HAS_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+namespace cpparse {
+
+	/**
+	 * Read-only view of the contents of a file.
+	 *
+	 * On POSIX systems a regular file is memory-mapped, so that large files are
+	 * paged in as they are read instead of being copied into memory up front.
+	 * Pipes, FIFOs, terminals and files that report no size (e.g. under /proc)
+	 * cannot be mapped, so they are read into memory instead, as are all files
+	 * on other systems.
+	 */
+	class Mapped_File {
+	public:
+
+		/**
+		 * Map or read the file at the given path.
+		 *
+		 * @param path  file path
+		 * @throw std::runtime_error  If the file cannot be opened, mapped or read.
+		 */
+		explicit Mapped_File(const std::string &path) {
+#ifdef CPARSEPARSE_HAS_MMAP
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				throw std::runtime_error{"cannot open file '" + path + "'"};
+			struct stat st;
+			if (::fstat(fd, &st) != 0) {
+				::close(fd);
+				throw std::runtime_error{"cannot open file '" + path + "'"};
+			}
+			if (S_ISREG(st.st_mode) && st.st_size > 0) {
+				m_size = static_cast<std::size_t>(st.st_size);
+				const auto p_map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (p_map == MAP_FAILED) {
+					::close(fd);
+					throw std::runtime_error{"cannot map file '" + path + "'"};
+				}
+				m_data = static_cast<const char *>(p_map);
+				m_mapped = true;
+				::madvise(p_map, m_size, MADV_SEQUENTIAL);
+			} else {
+				try {
+					read_contents(fd, path);
+				} catch (...) {
+					::close(fd);
+					throw;
+				}
+			}
+			::close(fd);
+#else
+			std::ifstream in{path, std::ios::binary};
+			if (!in)
+				throw std::runtime_error{"cannot open file '" + path + "'"};
+			m_contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+			m_data = m_contents.data();
+			m_size = m_contents.size();
+#endif /* CPARSEPARSE_HAS_MMAP */
+		}
+
+		~Mapped_File() {
+#ifdef CPARSEPARSE_HAS_MMAP
+			if (m_mapped)
+				::munmap(const_cast<char *>(m_data), m_size);
+#endif /* CPARSEPARSE_HAS_MMAP */
+		}
+
+		Mapped_File(const Mapped_File &) = delete;
+		Mapped_File &operator=(const Mapped_File &) = delete;
+
+		const char *data() const noexcept {
+			return m_data;
+		}
+
+		std::size_t size() const noexcept {
+			return m_size;
+		}
+
+	private:
+		const char *m_data{nullptr};
+		std::size_t m_size{0};
+		std::string m_contents;  // Contents of a file that is not mapped
+#ifdef CPARSEPARSE_HAS_MMAP
+		bool m_mapped{false};
+
+		/**
+		 * Read the file into memory until the end of the stream.
+		 */
+		void read_contents(int fd, const std::string &path) {
+			constexpr std::size_t CHUNK_SIZE{64 * 1024};
+			for (;;) {
+				const auto size = m_contents.size();
+				m_contents.resize(size + CHUNK_SIZE);
+				const auto n_read = ::read(fd, &m_contents[size], CHUNK_SIZE);
+				if (n_read < 0 && errno == EINTR) {
+					m_contents.resize(size);
+					continue;
+				}
+				if (n_read < 0)
+					throw std::runtime_error{"cannot read file '" + path + "'"};
+				m_contents.resize(size + static_cast<std::size_t>(n_read));
+				if (n_read == 0)
+					break;
+			}
+			m_data = m_contents.data();
+			m_size = m_contents.size();
+		}
+#endif /* CPARSEPARSE_HAS_MMAP */
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_MAPPED_FILE_H_ */
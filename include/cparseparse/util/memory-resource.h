@@ -0,0 +1,462 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_MEMORY_RESOURCE_H_
+#define CPARSEPARSE_UTIL_MEMORY_RESOURCE_H_
+
+#include "cparseparse/util/string-view.h"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define CPARSEPARSE_HAS_PMR 1
+#endif /* __has_include(<memory_resource>) */
+#endif /* __cplusplus >= 201703L && defined(__has_include) */
+
+namespace cpparse {
+
+#ifdef CPARSEPARSE_HAS_PMR
+	using Memory_Resource = std::pmr::memory_resource;
+	using Monotonic_Buffer_Resource = std::pmr::monotonic_buffer_resource;
+
+	/**
+	 * @return the resource used by parsers that are not given one explicitly
+	 */
+	inline Memory_Resource *default_resource() noexcept {
+		return std::pmr::get_default_resource();
+	}
+#else
+	/**
+	 * Abstract memory resource for pre-C++17 builds.
+	 *
+	 * Provides the same interface as @a std::pmr::memory_resource, which is used in
+	 * its place for C++17 and later.
+	 */
+	class Memory_Resource {
+	public:
+		virtual ~Memory_Resource() = default;
+
+		void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+			return do_allocate(bytes, alignment);
+		}
+
+		void deallocate(void *p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+			do_deallocate(p, bytes, alignment);
+		}
+
+		bool is_equal(const Memory_Resource &other) const noexcept {
+			return do_is_equal(other);
+		}
+
+	private:
+		virtual void *do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+		virtual void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) = 0;
+		virtual bool do_is_equal(const Memory_Resource &other) const noexcept = 0;
+	};
+
+	/**
+	 * Memory resource that forwards to the global @a operator new and
+	 * @a operator delete.
+	 */
+	class New_Delete_Resource : public Memory_Resource {
+	private:
+		void *do_allocate(std::size_t bytes, std::size_t) override {
+			return ::operator new(bytes);
+		}
+
+		void do_deallocate(void *p, std::size_t, std::size_t) override {
+			::operator delete(p);
+		}
+
+		bool do_is_equal(const Memory_Resource &other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+	/**
+	 * @return the resource used by parsers that are not given one explicitly
+	 */
+	inline Memory_Resource *default_resource() noexcept {
+		static New_Delete_Resource resource;
+		return &resource;
+	}
+
+	/**
+	 * Monotonic arena for pre-C++17 builds.
+	 *
+	 * Memory is carved sequentially out of geometrically growing blocks obtained
+	 * from the upstream resource. Deallocation is a no-op; all blocks are returned
+	 * at once by release() or on destruction. Provides the same interface as
+	 * @a std::pmr::monotonic_buffer_resource, which is used in its place for C++17
+	 * and later.
+	 */
+	class Monotonic_Buffer_Resource : public Memory_Resource {
+	public:
+		explicit Monotonic_Buffer_Resource(Memory_Resource *upstream = default_resource()) noexcept
+				: Monotonic_Buffer_Resource{1024, upstream} { }
+
+		explicit Monotonic_Buffer_Resource(std::size_t initial_size, Memory_Resource *upstream = default_resource()) noexcept
+				: m_upstream{upstream},
+				  m_next_size{initial_size ? initial_size : 1} { }
+
+		Monotonic_Buffer_Resource(void *buffer, std::size_t buffer_size, Memory_Resource *upstream = default_resource()) noexcept
+				: m_upstream{upstream},
+				  m_current{static_cast<char *>(buffer)},
+				  m_remaining{buffer_size},
+				  m_next_size{buffer_size ? buffer_size * 2 : 1024} { }
+
+		~Monotonic_Buffer_Resource() override {
+			release();
+		}
+
+		Monotonic_Buffer_Resource(const Monotonic_Buffer_Resource &) = delete;
+		Monotonic_Buffer_Resource &operator=(const Monotonic_Buffer_Resource &) = delete;
+
+		/**
+		 * Return all blocks obtained from the upstream resource.
+		 */
+		void release() noexcept {
+			while (m_blocks) {
+				const auto block = m_blocks;
+				m_blocks = block->next;
+				m_upstream->deallocate(block, block->size, alignof(Block));
+			}
+			m_current = nullptr;
+			m_remaining = 0;
+		}
+
+		Memory_Resource *upstream_resource() const noexcept {
+			return m_upstream;
+		}
+
+	private:
+
+		/**
+		 * Header placed at the start of each upstream block.
+		 */
+		struct alignas(std::max_align_t) Block {
+			Block *next;
+			std::size_t size;
+		};
+
+		Memory_Resource *m_upstream;
+		Block *m_blocks{nullptr};
+		char *m_current{nullptr};
+		std::size_t m_remaining{0};
+		std::size_t m_next_size;
+
+		void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+			auto padding = aligned_padding(alignment);
+			if (padding + bytes > m_remaining) {
+				allocate_block(bytes + alignment);
+				padding = aligned_padding(alignment);
+			}
+			const auto p = m_current + padding;
+			m_current = p + bytes;
+			m_remaining -= padding + bytes;
+			return p;
+		}
+
+		void do_deallocate(void *, std::size_t, std::size_t) override { }
+
+		bool do_is_equal(const Memory_Resource &other) const noexcept override {
+			return this == &other;
+		}
+
+		std::size_t aligned_padding(std::size_t alignment) const noexcept {
+			const auto misalignment = reinterpret_cast<std::size_t>(m_current) % alignment;
+			return misalignment ? alignment - misalignment : 0;
+		}
+
+		void allocate_block(std::size_t min_bytes) {
+			auto size = m_next_size;
+			while (size < min_bytes + sizeof(Block))
+				size *= 2;
+			const auto block = static_cast<Block *>(m_upstream->allocate(size, alignof(Block)));
+			block->next = m_blocks;
+			block->size = size;
+			m_blocks = block;
+			m_current = reinterpret_cast<char *>(block + 1);
+			m_remaining = size - sizeof(Block);
+			m_next_size = size * 2;
+		}
+	};
+#endif /* CPARSEPARSE_HAS_PMR */
+
+#ifdef CPARSEPARSE_INSTRUMENTATION
+	/**
+	 * Allocations made for parser-owned storage by the calling thread, reported in
+	 * the metrics of instrumented parses.
+	 */
+	struct _Allocation_Stats {
+		std::size_t count;
+		std::size_t bytes;
+	};
+
+	inline _Allocation_Stats &_allocation_stats() noexcept {
+		static thread_local _Allocation_Stats stats{0, 0};
+		return stats;
+	}
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+
+	/**
+	 * Allocate memory for parser-owned storage from the resource.
+	 */
+	inline void *_resource_allocate(Memory_Resource *resource, std::size_t bytes, std::size_t alignment) {
+		const auto p = resource->allocate(bytes, alignment);
+#ifdef CPARSEPARSE_INSTRUMENTATION
+		auto &stats = _allocation_stats();
+		++stats.count;
+		stats.bytes += bytes;
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+		return p;
+	}
+
+	/**
+	 * Allocator that obtains memory from a Memory_Resource.
+	 *
+	 * Unlike @a std::pmr::polymorphic_allocator, the allocator propagates on
+	 * container move assignment and swap, so that containers of non-movable
+	 * elements (such as argument info objects) remain move-assignable.
+	 */
+	template<class T>
+	class Resource_Allocator {
+	public:
+		using value_type = T;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		Resource_Allocator(Memory_Resource *resource = default_resource()) noexcept
+				: m_resource{resource} { }
+
+		template<class U>
+		Resource_Allocator(const Resource_Allocator<U> &other) noexcept
+				: m_resource{other.resource()} { }
+
+		T *allocate(std::size_t n) {
+			return static_cast<T *>(_resource_allocate(m_resource, n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T *p, std::size_t n) noexcept {
+			m_resource->deallocate(p, n * sizeof(T), alignof(T));
+		}
+
+		Memory_Resource *resource() const noexcept {
+			return m_resource;
+		}
+
+		template<class U>
+		friend bool operator==(const Resource_Allocator &lhs, const Resource_Allocator<U> &rhs) noexcept {
+			return lhs.m_resource == rhs.resource() || lhs.m_resource->is_equal(*rhs.resource());
+		}
+
+		template<class U>
+		friend bool operator!=(const Resource_Allocator &lhs, const Resource_Allocator<U> &rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+	private:
+		Memory_Resource *m_resource;
+	};
+
+	/**
+	 * Growable character buffer allocated from a Memory_Resource.
+	 *
+	 * The buffer is only reallocated when a larger capacity is requested, so
+	 * repeated use with similarly sized contents does not allocate.
+	 */
+	class Resource_Buffer {
+	public:
+		explicit Resource_Buffer(Memory_Resource *resource = default_resource()) noexcept
+				: m_resource{resource} { }
+
+		~Resource_Buffer() {
+			deallocate();
+		}
+
+		Resource_Buffer(Resource_Buffer &&other) noexcept
+				: m_resource{other.m_resource},
+				  m_data{other.m_data},
+				  m_capacity{other.m_capacity} {
+			other.m_data = nullptr;
+			other.m_capacity = 0;
+		}
+
+		Resource_Buffer &operator=(Resource_Buffer &&other) noexcept {
+			if (this != &other) {
+				deallocate();
+				m_resource = other.m_resource;
+				m_data = other.m_data;
+				m_capacity = other.m_capacity;
+				other.m_data = nullptr;
+				other.m_capacity = 0;
+			}
+			return *this;
+		}
+
+		Resource_Buffer(const Resource_Buffer &) = delete;
+		Resource_Buffer &operator=(const Resource_Buffer &) = delete;
+
+		char *data() const noexcept {
+			return m_data;
+		}
+
+		std::size_t capacity() const noexcept {
+			return m_capacity;
+		}
+
+		/**
+		 * Ensure the buffer can hold at least @a size characters.
+		 *
+		 * Any existing contents are discarded when the buffer is reallocated.
+		 */
+		void reserve(std::size_t size) {
+			if (size <= m_capacity)
+				return;
+			deallocate();
+			m_data = static_cast<char *>(_resource_allocate(m_resource, size, 1));
+			m_capacity = size;
+		}
+
+	private:
+		Memory_Resource *m_resource;
+		char *m_data{nullptr};
+		std::size_t m_capacity{0};
+
+		void deallocate() noexcept {
+			if (m_data)
+				m_resource->deallocate(m_data, m_capacity, 1);
+			m_data = nullptr;
+			m_capacity = 0;
+		}
+	};
+
+	/**
+	 * Append-only string storage allocated in blocks from a Memory_Resource.
+	 *
+	 * Unlike Resource_Buffer, stored strings keep their addresses as more are
+	 * added, so values can be copied in one at a time as they are read. All blocks
+	 * are returned on destruction.
+	 */
+	class String_Arena {
+	public:
+		explicit String_Arena(Memory_Resource *resource = default_resource()) noexcept
+				: m_resource{resource} { }
+
+		~String_Arena() {
+			release();
+		}
+
+		String_Arena(String_Arena &&other) noexcept
+				: m_resource{other.m_resource},
+				  m_blocks{other.m_blocks},
+				  m_current{other.m_current},
+				  m_remaining{other.m_remaining} {
+			other.m_blocks = nullptr;
+			other.m_current = nullptr;
+			other.m_remaining = 0;
+		}
+
+		String_Arena &operator=(String_Arena &&other) noexcept {
+			if (this != &other) {
+				release();
+				m_resource = other.m_resource;
+				m_blocks = other.m_blocks;
+				m_current = other.m_current;
+				m_remaining = other.m_remaining;
+				other.m_blocks = nullptr;
+				other.m_current = nullptr;
+				other.m_remaining = 0;
+			}
+			return *this;
+		}
+
+		String_Arena(const String_Arena &) = delete;
+		String_Arena &operator=(const String_Arena &) = delete;
+
+		/**
+		 * Ensure that the next @a size characters can be stored without allocating.
+		 */
+		void reserve(std::size_t size) {
+			if (size > m_remaining)
+				allocate_block(size);
+		}
+
+		/**
+		 * Copy the string into the arena, followed by a null terminator.
+		 *
+		 * @param value  string to copy
+		 * @return a view of the copy
+		 */
+		String_View store(String_View value) {
+			reserve(value.size() + 1);
+			const auto p = m_current;
+			/* An empty view may have a null data pointer, which memcpy() does not allow */
+			if (!value.empty())
+				std::memcpy(p, value.data(), value.size());
+			p[value.size()] = '\0';
+			m_current += value.size() + 1;
+			m_remaining -= value.size() + 1;
+			return String_View{p, value.size()};
+		}
+
+		/**
+		 * Free every stored string, invalidating the views of them.
+		 */
+		void clear() noexcept {
+			release();
+		}
+
+	private:
+
+		/**
+		 * Header placed at the start of each block.
+		 */
+		struct alignas(std::max_align_t) Block {
+			Block *next;
+			std::size_t size;
+		};
+
+		/** Size of the first block allocated without a reservation */
+		static constexpr std::size_t MIN_BLOCK_SIZE{256};
+
+		Memory_Resource *m_resource;
+		Block *m_blocks{nullptr};
+		char *m_current{nullptr};
+		std::size_t m_remaining{0};
+
+		void allocate_block(std::size_t min_size) {
+			auto size = m_blocks ? m_blocks->size * 2 : std::size_t{MIN_BLOCK_SIZE};
+			while (size < min_size + sizeof(Block))
+				size *= 2;
+			const auto block = static_cast<Block *>(_resource_allocate(m_resource, size, alignof(Block)));
+			block->next = m_blocks;
+			block->size = size;
+			m_blocks = block;
+			m_current = reinterpret_cast<char *>(block + 1);
+			m_remaining = size - sizeof(Block);
+		}
+
+		void release() noexcept {
+			while (m_blocks) {
+				const auto block = m_blocks;
+				m_blocks = block->next;
+				m_resource->deallocate(block, block->size, alignof(Block));
+			}
+			m_current = nullptr;
+			m_remaining = 0;
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_MEMORY_RESOURCE_H_ */
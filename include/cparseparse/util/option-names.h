@@ -0,0 +1,300 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_OPTION_NAMES_H_
+#define CPARSEPARSE_UTIL_OPTION_NAMES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Vector instruction set used to scan option names, chosen at compile time.
+ * Define CPARSEPARSE_NO_SIMD to always use the scalar implementation.
+ */
+#ifndef CPARSEPARSE_NO_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CPARSEPARSE_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPARSEPARSE_SIMD_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CPARSEPARSE_SIMD_NEON 1
+#endif
+#endif /* CPARSEPARSE_NO_SIMD */
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif /* defined(_MSC_VER) && !defined(__clang__) */
+
+namespace cpparse {
+
+	/**
+	 * Determine if the character may start an option name ([a-zA-Z_]).
+	 */
+	constexpr bool is_name_start_char(char c) noexcept {
+		return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_';
+	}
+
+	/**
+	 * Determine if the character may appear within an option name ([a-zA-Z0-9_-]).
+	 */
+	constexpr bool is_name_char(char c) noexcept {
+		return is_name_start_char(c) || ('0' <= c && c <= '9') || c == '-';
+	}
+
+	/**
+	 * Find the first character at or after @a p that may not appear within an
+	 * option name, checking one character at a time.
+	 *
+	 * @return a pointer to the character, which is at the latest the null
+	 *         terminator
+	 */
+	inline const char *scan_name_chars_scalar(const char *p) noexcept {
+		while (is_name_char(*p))
+			++p;
+		return p;
+	}
+
+	/**
+	 * Find the first character in [@a p, @a end) that may not appear within an
+	 * option name, checking one character at a time.
+	 *
+	 * @return a pointer to the character, or @a end if there is none
+	 */
+	inline const char *scan_name_chars_scalar(const char *p, const char *end) noexcept {
+		while (p != end && is_name_char(*p))
+			++p;
+		return p;
+	}
+
+#if defined(CPARSEPARSE_SIMD_AVX2) || defined(CPARSEPARSE_SIMD_SSE2) || defined(CPARSEPARSE_SIMD_NEON)
+#if defined(CPARSEPARSE_SIMD_AVX2)
+	/** Number of characters checked at a time */
+	constexpr std::size_t _NAME_SCAN_BLOCK{32};
+
+	/** Number of mask bits per character returned by _invalid_name_chars() */
+	constexpr unsigned _NAME_SCAN_MASK_BITS{1};
+
+	/**
+	 * @return a mask of the characters in the block that may not appear within an
+	 *         option name
+	 */
+	inline std::uint64_t _invalid_name_chars(const char *block) noexcept {
+		const auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+		const auto lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+		const auto alpha = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)),
+				_mm256_add_epi8(lower, _mm256_set1_epi8(static_cast<char>(0x80 - 'a'))));
+		const auto digit = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 10)),
+				_mm256_add_epi8(chars, _mm256_set1_epi8(static_cast<char>(0x80 - '0'))));
+		const auto punct = _mm256_or_si256(_mm256_cmpeq_epi8(chars, _mm256_set1_epi8('_')), _mm256_cmpeq_epi8(chars, _mm256_set1_epi8('-')));
+		const auto valid = _mm256_or_si256(_mm256_or_si256(alpha, digit), punct);
+		return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(valid));
+	}
+#elif defined(CPARSEPARSE_SIMD_SSE2)
+	constexpr std::size_t _NAME_SCAN_BLOCK{16};
+	constexpr unsigned _NAME_SCAN_MASK_BITS{1};
+
+	inline std::uint64_t _invalid_name_chars(const char *block) noexcept {
+		/* Signed comparisons only, so each range is shifted to start at -128 */
+		const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+		const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+		const auto alpha = _mm_cmplt_epi8(_mm_add_epi8(lower, _mm_set1_epi8(static_cast<char>(0x80 - 'a'))),
+				_mm_set1_epi8(static_cast<char>(0x80 + 26)));
+		const auto digit = _mm_cmplt_epi8(_mm_add_epi8(chars, _mm_set1_epi8(static_cast<char>(0x80 - '0'))),
+				_mm_set1_epi8(static_cast<char>(0x80 + 10)));
+		const auto punct = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8('_')), _mm_cmpeq_epi8(chars, _mm_set1_epi8('-')));
+		const auto valid = _mm_or_si128(_mm_or_si128(alpha, digit), punct);
+		return ~static_cast<std::uint32_t>(_mm_movemask_epi8(valid)) & 0xFFFF;
+	}
+#else
+	constexpr std::size_t _NAME_SCAN_BLOCK{16};
+	constexpr unsigned _NAME_SCAN_MASK_BITS{4};
+
+	inline std::uint64_t _invalid_name_chars(const char *block) noexcept {
+		const auto chars = vld1q_u8(reinterpret_cast<const std::uint8_t *>(block));
+		const auto lower = vorrq_u8(chars, vdupq_n_u8(0x20));
+		const auto alpha = vcltq_u8(vsubq_u8(lower, vdupq_n_u8('a')), vdupq_n_u8(26));
+		const auto digit = vcltq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(10));
+		const auto punct = vorrq_u8(vceqq_u8(chars, vdupq_n_u8('_')), vceqq_u8(chars, vdupq_n_u8('-')));
+		const auto invalid = vmvnq_u8(vorrq_u8(vorrq_u8(alpha, digit), punct));
+
+		/* Narrow each byte of the comparison to a nibble of the mask */
+		const auto nibbles = vshrn_n_u16(vreinterpretq_u16_u8(invalid), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+	}
+#endif
+
+	/**
+	 * @return the index of the lowest set bit of the non-zero mask
+	 */
+	inline unsigned _lowest_set_bit(std::uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned>(__builtin_ctzll(mask));
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		unsigned index{0};
+		for (; !(mask & 1); mask >>= 1)
+			++index;
+		return index;
+#endif
+	}
+
+	/**
+	 * Find the first character in [@a p, @a end) that may not appear within an
+	 * option name, checking a block of characters at a time with vector
+	 * instructions.
+	 *
+	 * Only blocks that lie within the range are loaded: once fewer than a block's
+	 * characters remain, the last block of the range is checked again, ignoring
+	 * the characters already checked. Ranges shorter than a block are checked one
+	 * character at a time.
+	 *
+	 * @return a pointer to the character, or @a end if there is none
+	 */
+	inline const char *scan_name_chars(const char *p, const char *end) noexcept {
+		if (static_cast<std::size_t>(end - p) < _NAME_SCAN_BLOCK)
+			return scan_name_chars_scalar(p, end);
+		for (; static_cast<std::size_t>(end - p) >= _NAME_SCAN_BLOCK; p += _NAME_SCAN_BLOCK) {
+			const auto mask = _invalid_name_chars(p);
+			if (mask)
+				return p + _lowest_set_bit(mask) / _NAME_SCAN_MASK_BITS;
+		}
+		if (p == end)
+			return end;
+		const auto block = end - _NAME_SCAN_BLOCK;
+		const auto mask = _invalid_name_chars(block) & (~std::uint64_t{0} << ((p - block) * _NAME_SCAN_MASK_BITS));
+		return mask ? block + _lowest_set_bit(mask) / _NAME_SCAN_MASK_BITS : end;
+	}
+
+	/**
+	 * Find the first character at or after @a p that may not appear within an
+	 * option name.
+	 *
+	 * The end of the string is found first, so that the vector scan of
+	 * scan_name_chars(const char *, const char *) never reads past the null
+	 * terminator.
+	 *
+	 * @return a pointer to the character, which is at the latest the null
+	 *         terminator
+	 */
+	inline const char *scan_name_chars(const char *p) noexcept {
+		return scan_name_chars(p, p + std::strlen(p));
+	}
+
+	/**
+	 * @return the name of the vector instruction set used by scan_name_chars()
+	 */
+	constexpr const char *name_scan_instruction_set() noexcept {
+#if defined(CPARSEPARSE_SIMD_AVX2)
+		return "avx2";
+#elif defined(CPARSEPARSE_SIMD_SSE2)
+		return "sse2";
+#else
+		return "neon";
+#endif
+	}
+#else
+	/**
+	 * Find the first character in [@a p, @a end) that may not appear within an
+	 * option name.
+	 *
+	 * No vector instruction set is available, so the characters are checked one
+	 * at a time.
+	 *
+	 * @return a pointer to the character, or @a end if there is none
+	 */
+	inline const char *scan_name_chars(const char *p, const char *end) noexcept {
+		return scan_name_chars_scalar(p, end);
+	}
+
+	/**
+	 * Find the first character at or after @a p that may not appear within an
+	 * option name, checking one character at a time.
+	 *
+	 * @return a pointer to the character, which is at the latest the null
+	 *         terminator
+	 */
+	inline const char *scan_name_chars(const char *p) noexcept {
+		return scan_name_chars_scalar(p);
+	}
+
+	constexpr const char *name_scan_instruction_set() noexcept {
+		return "scalar";
+	}
+#endif
+
+	/**
+	 * Check whether the positional argument name is valid (\w[a-zA-Z0-9_-]*).
+	 */
+	inline bool valid_positional_name(const char *name) noexcept {
+		if (!is_name_start_char(*name) && !('0' <= *name && *name <= '9'))
+			return false;
+		return !*scan_name_chars(name + 1);
+	}
+
+	/**
+	 * Locate the reference name within a "long" option name
+	 * (--?([a-zA-Z_][a-zA-Z0-9_-]+)).
+	 *
+	 * @return a pointer to the first character following the leading dashes, or
+	 *         @a nullptr if @a name is not a valid "long" option name
+	 */
+	inline const char *long_option_name(const char *name) noexcept {
+		if (*name != '-')
+			return nullptr;
+		if (*++name == '-')
+			++name;
+		if (!is_name_start_char(*name) || !name[1])
+			return nullptr;
+		return *scan_name_chars(name + 1) ? nullptr : name;
+	}
+
+	/**
+	 * Locate the reference name within a "long" option token that may carry an
+	 * attached value (--?([a-zA-Z_][a-zA-Z0-9_-]+)(=.*)?).
+	 *
+	 * @param end  set to the character following the name, which is either the
+	 *             null terminator or the '=' preceding the value
+	 * @return a pointer to the first character following the leading dashes, or
+	 *         @a nullptr if @a token does not start with a valid "long" option name
+	 */
+	inline const char *long_option_name(const char *token, const char *&end) noexcept {
+		if (*token != '-')
+			return nullptr;
+		if (*++token == '-')
+			++token;
+		if (!is_name_start_char(*token))
+			return nullptr;
+		end = scan_name_chars(token + 1);
+		return end - token >= 2 && (!*end || *end == '=') ? token : nullptr;
+	}
+
+	/**
+	 * Extract the flag character from a flag name (-([a-zA-Z_])).
+	 *
+	 * @return the flag character, or 0 if @a name is not a valid flag name
+	 */
+	inline char flag_option_name(const char *name) noexcept {
+		return name[0] == '-' && is_name_start_char(name[1]) && !name[2] ? name[1] : 0;
+	}
+
+	/**
+	 * Check whether the string is a valid flag or "long" option name
+	 * (-([a-zA-Z_]|-?[a-zA-Z_][a-zA-Z0-9_-]+)).
+	 */
+	inline bool valid_option_name(const char *name) noexcept {
+		return flag_option_name(name) || long_option_name(name);
+	}
+
+}
+
+#endif /* CPARSEPARSE_UTIL_OPTION_NAMES_H_ */
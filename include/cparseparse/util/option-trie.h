@@ -0,0 +1,268 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_OPTION_TRIE_H_
+#define CPARSEPARSE_UTIL_OPTION_TRIE_H_
+
+#include "cparseparse/util/memory-resource.h"
+#include "cparseparse/util/string-view.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Index of option reference names for resolving command-line tokens, held as a
+	 * path-compressed trie in two contiguous arrays.
+	 *
+	 * Looking up a name compares each of its characters once and does not allocate
+	 * or hash. The children of each node are stored next to each other, so that
+	 * choosing the branch at each point where names diverge scans a single range
+	 * of memory. Each node also records whether exactly one name passes through
+	 * it, so that an unambiguous prefix of a name (e.g. @a verb for @a verbose) is
+	 * resolved by the same walk.
+	 */
+	class Option_Trie {
+	public:
+
+		/** Returned by the lookup functions when no name matches */
+		static constexpr std::size_t NO_MATCH{static_cast<std::size_t>(-1)};
+
+		/** Returned by find_prefix() when the prefix starts several names */
+		static constexpr std::size_t AMBIGUOUS{static_cast<std::size_t>(-2)};
+
+		/**
+		 * @param resource  memory resource from which the index is allocated
+		 */
+		explicit Option_Trie(Memory_Resource *resource = default_resource())
+				: m_nodes{Resource_Allocator<Node>{resource}},
+				  m_labels{Resource_Allocator<char>{resource}} {
+			m_nodes.push_back(Node{0, 0, 0, 0, 0, NONE, NONE, 0});
+		}
+
+		/**
+		 * @return the number of names in the index
+		 */
+		std::size_t size() const noexcept {
+			return m_size;
+		}
+
+		/**
+		 * Add a name to the index.
+		 *
+		 * The index is left unchanged if an allocation throws.
+		 *
+		 * @param name   non-empty reference name
+		 * @param value  value to associate with the name, less than AMBIGUOUS
+		 * @return true if the name was added, or false if it was already present
+		 */
+		bool insert(String_View name, std::size_t value) {
+			if (find(name) != NO_MATCH)
+				return false;
+			/* At most one child list grows and one is created by splitting an edge */
+			reserve_more(m_nodes, 2 * m_max_child_capacity + 2);
+			reserve_more(m_labels, name.size());
+
+			const auto tagged = static_cast<std::uint32_t>(value);
+			std::uint32_t node{0};
+			std::size_t pos{0};
+			while (pos < name.size()) {
+				const auto child = find_child(node, name[pos]);
+				if (child == NONE) {
+					const Node leaf{static_cast<std::uint32_t>(m_labels.size()), static_cast<std::uint32_t>(name.size() - pos), 0, 0, 0, tagged, tagged, name[pos]};
+					m_labels.insert(m_labels.end(), name.begin() + pos, name.end());
+					node = add_child(node, leaf);
+					break;
+				}
+
+				const auto edge = m_labels.data() + m_nodes[child].edge;
+				std::size_t common{1};
+				while (common < m_nodes[child].edge_length && pos + common < name.size() && edge[common] == name[pos + common])
+					++common;
+				if (common < m_nodes[child].edge_length)
+					split(child, static_cast<std::uint32_t>(common));
+				auto &unique = m_nodes[child].unique;
+				unique = unique == NONE ? tagged : SEVERAL;
+				node = child;
+				pos += common;
+			}
+			m_nodes[node].value = tagged;
+			++m_size;
+			return true;
+		}
+
+		/**
+		 * Reserve storage for @a names more names of @a chars characters in total, so
+		 * that adding a known set of names allocates once in most cases.
+		 */
+		void reserve(std::size_t names, std::size_t chars) {
+			/* Each name adds a leaf and may split an edge, and growing child lists move */
+			reserve_more(m_nodes, 4 * names + 2 * m_max_child_capacity + 2);
+			reserve_more(m_labels, chars);
+		}
+
+		/**
+		 * Look up a name exactly.
+		 *
+		 * @return the value associated with @a name, or NO_MATCH
+		 */
+		std::size_t find(String_View name) const noexcept {
+			bool inside_edge;
+			const auto node = walk(name, inside_edge);
+			return node == NONE || inside_edge ? NO_MATCH : to_result(m_nodes[node].value);
+		}
+
+		/**
+		 * Look up a name or an abbreviation of one.
+		 *
+		 * A name that is present matches exactly, even if it is also the prefix of
+		 * other names.
+		 *
+		 * @return the value associated with @a prefix or with the only name that
+		 *         starts with it, AMBIGUOUS if several names start with it, or NO_MATCH
+		 */
+		std::size_t find_prefix(String_View prefix) const noexcept {
+			if (prefix.empty())
+				return NO_MATCH;
+			bool inside_edge;
+			const auto node = walk(prefix, inside_edge);
+			if (node == NONE)
+				return NO_MATCH;
+			if (!inside_edge && m_nodes[node].value != NONE)
+				return m_nodes[node].value;
+			return to_result(m_nodes[node].unique);
+		}
+
+	private:
+
+		/* Node field values that do not refer to a name */
+		static constexpr std::uint32_t NONE{static_cast<std::uint32_t>(-1)};
+		static constexpr std::uint32_t SEVERAL{static_cast<std::uint32_t>(-2)};
+
+		/**
+		 * Node reached by the characters of its incoming edge, stored in the child
+		 * list of its parent.
+		 */
+		struct Node {
+			std::uint32_t edge;            // Offset of the edge characters in m_labels
+			std::uint32_t edge_length;
+			std::uint32_t children;        // Offset of the child list in m_nodes
+			std::uint32_t child_count;
+			std::uint32_t child_capacity;
+			std::uint32_t value;           // Value of the name ending here, or NONE
+			std::uint32_t unique;          // Value of the only name ending here or below, SEVERAL, or NONE
+			char first;                    // First edge character
+		};
+
+		std::vector<Node, Resource_Allocator<Node>> m_nodes;  // The root, then child lists, moved to the end when they grow
+		std::vector<char, Resource_Allocator<char>> m_labels;
+		std::uint32_t m_max_child_capacity{0};
+		std::size_t m_size{0};
+
+		/**
+		 * Scan the whole child list without stopping at the match, so that the scan
+		 * does not branch on the characters.
+		 */
+		std::uint32_t find_child(std::uint32_t node, char c) const noexcept {
+			const auto first = m_nodes[node].children;
+			const auto last = first + m_nodes[node].child_count;
+			auto found = NONE;
+			for (auto child = first; child != last; ++child)
+				found = m_nodes[child].first == c ? child : found;
+			return found;
+		}
+
+		/**
+		 * @param inside_edge  set to true if @a name ends partway along the edge to
+		 *                     the returned node
+		 * @return the node reached by the characters of @a name, or NONE
+		 */
+		std::uint32_t walk(String_View name, bool &inside_edge) const noexcept {
+			std::uint32_t node{0};
+			std::size_t pos{0};
+			inside_edge = false;
+			while (pos < name.size()) {
+				node = find_child(node, name[pos]);
+				if (node == NONE)
+					return NONE;
+				const auto &child = m_nodes[node];
+				const auto length = std::min<std::size_t>(child.edge_length, name.size() - pos);
+				const auto edge = m_labels.data() + child.edge;
+				for (std::size_t i = 1; i < length; ++i) {  // The first character was matched by find_child()
+					if (edge[i] != name[pos + i])
+						return NONE;
+				}
+				pos += length;
+				inside_edge = length < child.edge_length;
+			}
+			return node;
+		}
+
+		/**
+		 * Append a node to the child list of another, moving the list to the end of
+		 * the reserved storage if it is full.
+		 *
+		 * @return the index of the added node
+		 */
+		std::uint32_t add_child(std::uint32_t parent, const Node &child) noexcept {
+			if (m_nodes[parent].child_count == m_nodes[parent].child_capacity) {
+				const auto capacity = m_nodes[parent].child_capacity ? 2 * m_nodes[parent].child_capacity : 2;
+				const auto offset = static_cast<std::uint32_t>(m_nodes.size());
+				m_nodes.resize(m_nodes.size() + capacity);
+				auto &node = m_nodes[parent];
+				std::copy(m_nodes.begin() + node.children, m_nodes.begin() + node.children + node.child_count, m_nodes.begin() + offset);
+				node.children = offset;
+				node.child_capacity = capacity;
+				m_max_child_capacity = std::max(m_max_child_capacity, capacity);
+			}
+			auto &node = m_nodes[parent];
+			const auto index = node.children + node.child_count++;
+			m_nodes[index] = child;
+			return index;
+		}
+
+		/**
+		 * Split the edge to a node after @a length characters, moving the rest of the
+		 * edge, the children and the value to a new node below it.
+		 */
+		void split(std::uint32_t node, std::uint32_t length) noexcept {
+			auto tail = m_nodes[node];
+			tail.edge += length;
+			tail.edge_length -= length;
+			tail.first = m_labels[tail.edge];
+
+			auto &head = m_nodes[node];
+			head.edge_length = length;
+			head.children = 0;
+			head.child_count = 0;
+			head.child_capacity = 0;
+			head.value = NONE;
+			add_child(node, tail);
+		}
+
+		/**
+		 * Make room for @a count more elements, at least doubling the capacity when
+		 * it grows so that a run of insertions reallocates a logarithmic number of
+		 * times.
+		 */
+		template<class Vector>
+		static void reserve_more(Vector &vec, std::size_t count) {
+			if (vec.capacity() - vec.size() < count)
+				vec.reserve(std::max(vec.size() + count, 2 * vec.capacity()));
+		}
+
+		static std::size_t to_result(std::uint32_t value) noexcept {
+			if (value == NONE)
+				return NO_MATCH;
+			return value == SEVERAL ? AMBIGUOUS : value;
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_OPTION_TRIE_H_ */
@@ -0,0 +1,93 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_PARALLEL_H_
+#define CPARSEPARSE_UTIL_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Invoke @a worker(self, failed) on up to @a n_workers threads, including the
+	 * calling thread, which runs as worker 0.
+	 *
+	 * If fewer threads can be started, some worker indices are never run, so the
+	 * workers that do run should take over any work assigned to the others.
+	 * The first exception thrown by any worker sets @a failed, a
+	 * @a std::atomic<bool> that the workers should check to stop early, and is
+	 * rethrown once every thread has finished.
+	 *
+	 * @param n_workers  maximum number of workers
+	 * @param worker     callable invoked with the worker index and failure flag
+	 */
+	template<class Worker>
+	void run_workers(std::size_t n_workers, Worker &&worker) {
+		std::atomic<bool> failed{false};
+		std::exception_ptr error;
+		std::mutex error_mutex;
+		const auto run = [&](std::size_t self) {
+			try {
+				worker(self, failed);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock{error_mutex};
+				if (!error)
+					error = std::current_exception();
+				failed.store(true, std::memory_order_relaxed);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		try {
+			threads.reserve(n_workers - 1);
+			for (std::size_t i = 1; i < n_workers; ++i)
+				threads.emplace_back(run, i);
+		} catch (const std::system_error &) {
+		} catch (const std::bad_alloc &) {
+		}
+		run(0);
+		for (auto &thread : threads)
+			thread.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	/**
+	 * Invoke @a work(i) for every index in [0, n) on up to @a n_threads threads,
+	 * including the calling thread.
+	 *
+	 * Indices are handed out one at a time, so the work items may take very
+	 * different amounts of time, e.g. when they wait on the file system or the
+	 * network. If fewer threads can be started, the remaining work is done by
+	 * those that were. The first exception thrown by any work item stops the
+	 * remaining items from being started and is rethrown once every thread has
+	 * finished.
+	 *
+	 * @param n          number of work items
+	 * @param n_threads  maximum number of threads
+	 * @param work       callable invoked with each index
+	 */
+	template<class Work>
+	void parallel_for(std::size_t n, unsigned n_threads, Work &&work) {
+		std::atomic<std::size_t> next{0};
+		run_workers(std::max<std::size_t>(std::min<std::size_t>(n_threads, n), 1), [&](std::size_t, const std::atomic<bool> &failed) {
+			for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < n && !failed.load(std::memory_order_relaxed);
+					i = next.fetch_add(1, std::memory_order_relaxed))
+				work(i);
+		});
+	}
+
+}
+
+#endif /* CPARSEPARSE_UTIL_PARALLEL_H_ */
@@ -0,0 +1,85 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_SHARED_REGION_H_
+#define CPARSEPARSE_UTIL_SHARED_REGION_H_
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define CPARSEPARSE_HAS_SHARED_MAPPING 1
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+namespace cpparse {
+
+	/**
+	 * Read-only copy of a block of memory in its own mapping.
+	 *
+	 * On POSIX systems the copy is placed in an anonymous shared mapping and then
+	 * write-protected, so that processes forked afterwards share its pages instead
+	 * of duplicating them on write, and no other allocation shares its pages.
+	 * Elsewhere the copy is held in a string.
+	 */
+	class Shared_Region {
+	public:
+
+		/**
+		 * Copy the data into a new read-only region.
+		 *
+		 * @param data  data to copy
+		 * @param size  size of the data in bytes
+		 * @throw std::bad_alloc  If the region cannot be mapped.
+		 */
+		Shared_Region(const char *data, std::size_t size)
+				: m_size{size} {
+#ifdef CPARSEPARSE_HAS_SHARED_MAPPING
+			if (!m_size)
+				return;
+			const auto p_map = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (p_map == MAP_FAILED)
+				throw std::bad_alloc{};
+			std::memcpy(p_map, data, m_size);
+			::mprotect(p_map, m_size, PROT_READ);
+			m_data = static_cast<const char *>(p_map);
+#else
+			m_contents.assign(data, size);
+			m_data = m_contents.data();
+#endif /* CPARSEPARSE_HAS_SHARED_MAPPING */
+		}
+
+		~Shared_Region() {
+#ifdef CPARSEPARSE_HAS_SHARED_MAPPING
+			if (m_data)
+				::munmap(const_cast<char *>(m_data), m_size);
+#endif /* CPARSEPARSE_HAS_SHARED_MAPPING */
+		}
+
+		Shared_Region(const Shared_Region &) = delete;
+		Shared_Region &operator=(const Shared_Region &) = delete;
+
+		const char *data() const noexcept {
+			return m_data;
+		}
+
+		std::size_t size() const noexcept {
+			return m_size;
+		}
+
+	private:
+		const char *m_data{nullptr};
+		std::size_t m_size;
+#ifndef CPARSEPARSE_HAS_SHARED_MAPPING
+		std::string m_contents;
+#endif /* CPARSEPARSE_HAS_SHARED_MAPPING */
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_SHARED_REGION_H_ */
@@ -0,0 +1,197 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_SNAPSHOT_H_
+#define CPARSEPARSE_UTIL_SNAPSHOT_H_
+
+#include "cparseparse/util/string-view.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace cpparse {
+
+	/*
+	 * Snapshot layout, in native byte order:
+	 *
+	 *   header   magic[8], version, byte-order mark, string pool offset, total size
+	 *   section  one per parser, starting with the top-level parser and followed
+	 *            by the section of its selected subcommand:
+	 *              definition fingerprint, positional count, optional count,
+	 *              extra count, selected subcommand (or NO_SUBCOMMAND),
+	 *              script name reference,
+	 *              one reference per positional value,
+	 *              per optional argument, its value count and value references,
+	 *              one reference per extra argument
+	 *   pool     the NUL-terminated strings named by the references
+	 *
+	 * Every field is a 32-bit unsigned integer, and a reference is the offset of a
+	 * string in the pool followed by its size.
+	 */
+
+	/** Identifies a snapshot blob */
+	constexpr char _SNAPSHOT_MAGIC[8] = {'C', 'P', 'A', 'R', 'S', 'N', 'A', 'P'};
+
+	/** Incremented whenever the snapshot layout changes */
+	constexpr std::uint32_t SNAPSHOT_VERSION{1};
+
+	/** Written in native byte order to detect snapshots from other machines */
+	constexpr std::uint32_t _SNAPSHOT_BYTE_ORDER{0x01020304};
+
+	/** Selected subcommand field when no subcommand was selected */
+	constexpr std::uint32_t _SNAPSHOT_NO_SUBCOMMAND{0xffffffff};
+
+	/** Size of the header: the magic and four fields */
+	constexpr std::size_t _SNAPSHOT_HEADER_SIZE{sizeof(_SNAPSHOT_MAGIC) + 4 * sizeof(std::uint32_t)};
+
+	/**
+	 * Builder of the sections and string pool of a snapshot.
+	 */
+	class _Snapshot_Writer {
+	public:
+
+		void put(std::uint32_t field) {
+			m_sections.append(reinterpret_cast<const char *>(&field), sizeof(field));
+		}
+
+		void put_size(std::size_t size) {
+			if (size > 0xffffffff)
+				throw std::length_error{"snapshot field exceeds 32 bits"};
+			put(static_cast<std::uint32_t>(size));
+		}
+
+		/**
+		 * Add a string to the pool and a reference to it to the current section.
+		 */
+		void put_string(String_View str) {
+			put_size(m_pool.size());
+			put_size(str.size());
+			m_pool.append(str.data(), str.size());
+			m_pool += '\0';
+		}
+
+		/**
+		 * @return the complete snapshot
+		 */
+		std::string finish() const {
+			const auto pool_offset = _SNAPSHOT_HEADER_SIZE + m_sections.size();
+			const auto total_size = pool_offset + m_pool.size();
+			if (total_size > 0xffffffff)
+				throw std::length_error{"snapshot exceeds 4 GiB"};
+			std::string blob;
+			blob.reserve(total_size);
+			blob.append(_SNAPSHOT_MAGIC, sizeof(_SNAPSHOT_MAGIC));
+			const std::uint32_t header[] = {SNAPSHOT_VERSION, _SNAPSHOT_BYTE_ORDER, static_cast<std::uint32_t>(pool_offset),
+					static_cast<std::uint32_t>(total_size)};
+			blob.append(reinterpret_cast<const char *>(header), sizeof(header));
+			blob += m_sections;
+			blob += m_pool;
+			return blob;
+		}
+
+	private:
+		std::string m_sections;
+		std::string m_pool;
+	};
+
+	/**
+	 * Bounds-checked reader of the sections of a snapshot, whose strings are
+	 * returned as views into the snapshot itself.
+	 */
+	class _Snapshot_Reader {
+	public:
+
+		/**
+		 * Check the header of a snapshot.
+		 *
+		 * @throw std::runtime_error  If the blob is not a complete snapshot of this
+		 *                            version and byte order.
+		 */
+		_Snapshot_Reader(const char *data, std::size_t size) {
+			if (size < _SNAPSHOT_HEADER_SIZE || std::memcmp(data, _SNAPSHOT_MAGIC, sizeof(_SNAPSHOT_MAGIC)) != 0)
+				fail("not a snapshot");
+			m_next = data + sizeof(_SNAPSHOT_MAGIC);
+			m_end = data + _SNAPSHOT_HEADER_SIZE;
+			if (get() != SNAPSHOT_VERSION)
+				fail("unsupported snapshot version");
+			if (get() != _SNAPSHOT_BYTE_ORDER)
+				fail("snapshot was written with a different byte order");
+			const std::size_t pool_offset{get()};
+			const std::size_t total_size{get()};
+			if (total_size != size || pool_offset < _SNAPSHOT_HEADER_SIZE || pool_offset > size)
+				fail("truncated snapshot");
+			m_end = data + pool_offset;
+			m_pool = data + pool_offset;
+			m_pool_size = size - pool_offset;
+		}
+
+		std::uint32_t get() {
+			if (static_cast<std::size_t>(m_end - m_next) < sizeof(std::uint32_t))
+				fail("truncated snapshot");
+			std::uint32_t field;
+			std::memcpy(&field, m_next, sizeof(field));
+			m_next += sizeof(field);
+			return field;
+		}
+
+		/**
+		 * Read a reference and return a view of the NUL-terminated string it names.
+		 */
+		String_View get_string() {
+			const std::size_t offset{get()};
+			const std::size_t size{get()};
+			if (offset >= m_pool_size || size >= m_pool_size - offset || m_pool[offset + size] != '\0')
+				fail("snapshot string out of bounds");
+			return String_View{m_pool + offset, size};
+		}
+
+		/**
+		 * @return true if every section has been read
+		 */
+		bool done() const noexcept {
+			return m_next == m_end;
+		}
+
+		[[noreturn]] static void fail(const char *reason) {
+			throw std::runtime_error{std::string{"invalid snapshot: "} + reason};
+		}
+
+	private:
+		const char *m_next;
+		const char *m_end;
+		const char *m_pool{nullptr};
+		std::size_t m_pool_size{0};
+	};
+
+	/**
+	 * Incremental 32-bit FNV-1a hash, used to fingerprint argument definitions.
+	 */
+	class _Fnv_Hash {
+	public:
+
+		void add(String_View str) noexcept {
+			for (const auto c : str)
+				add(c);
+			add('\0');
+		}
+
+		void add(char c) noexcept {
+			m_hash = (m_hash ^ static_cast<unsigned char>(c)) * 16777619u;
+		}
+
+		std::uint32_t value() const noexcept {
+			return m_hash;
+		}
+
+	private:
+		std::uint32_t m_hash{2166136261u};
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_SNAPSHOT_H_ */
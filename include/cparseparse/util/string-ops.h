@@ -7,19 +7,20 @@
 #ifndef CPARSEPARSE_UTIL_STRING_OPS_H_
 #define CPARSEPARSE_UTIL_STRING_OPS_H_
 
+#include "cparseparse/util/string-view.h"
 #include <algorithm>
+#include <cctype>
 #include <stdexcept>
 #include <string>
 
 namespace cpparse {
 
 	/**
- 	 * std::stoull overload to prevent unsigned integer wrap-around.
+	 * Append the string to @a out, converted to all uppercase characters.
 	 */
-	inline unsigned long long stoull(const std::string &value) {
-		if (value.find('-') != std::string::npos)
-			throw std::out_of_range{""};
-		return std::stoull(value);
+	inline void append_upper(const std::string &str, std::string &out) {
+		for (auto c : str)
+			out += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
 	}
 
 	/**
@@ -27,10 +28,33 @@ namespace cpparse {
 	 */
 	inline std::string str_to_upper(const std::string &str) {
 		std::string rtn;
-		std::transform(str.begin(), str.end(), std::back_inserter(rtn), toupper);
+		rtn.reserve(str.size());
+		append_upper(str, rtn);
 		return rtn;
 	}
 
+	/**
+	 * Append the environment variable name for an argument name to @a out: the
+	 * name in uppercase, with dashes replaced by underscores.
+	 */
+	inline void append_env_name(const std::string &name, std::string &out) {
+		for (auto c : name)
+			out += c == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	}
+
+	/**
+	 * @return the string without leading and trailing whitespace
+	 */
+	inline String_View trim_whitespace(String_View str) noexcept {
+		std::size_t begin{0};
+		std::size_t end{str.size()};
+		while (begin < end && std::isspace(static_cast<unsigned char>(str[begin])))
+			++begin;
+		while (end > begin && std::isspace(static_cast<unsigned char>(str[end - 1])))
+			--end;
+		return str.substr(begin, end - begin);
+	}
+
 }
 
 #endif /* CPARSEPARSE_UTIL_STRING_OPS_H_ */
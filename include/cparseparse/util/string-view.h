@@ -0,0 +1,180 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_STRING_VIEW_H_
+#define CPARSEPARSE_UTIL_STRING_VIEW_H_
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif /* __cplusplus >= 201703L */
+
+namespace cpparse {
+
+#if __cplusplus >= 201703L
+	using String_View = std::string_view;
+#else
+	/**
+	 * Minimal non-owning string reference for pre-C++17 builds.
+	 *
+	 * Provides the subset of the @a std::string_view interface used by the
+	 * library.
+	 */
+	class String_View {
+	public:
+		using const_iterator = const char *;
+
+		constexpr String_View() noexcept
+				: m_data{nullptr},
+				  m_size{0} { }
+
+		constexpr String_View(const char *data, std::size_t size) noexcept
+				: m_data{data},
+				  m_size{size} { }
+
+		String_View(const char *str) noexcept
+				: m_data{str},
+				  m_size{std::strlen(str)} { }
+
+		String_View(const std::string &str) noexcept
+				: m_data{str.data()},
+				  m_size{str.size()} { }
+
+		constexpr const char *data() const noexcept {
+			return m_data;
+		}
+
+		constexpr std::size_t size() const noexcept {
+			return m_size;
+		}
+
+		constexpr std::size_t length() const noexcept {
+			return m_size;
+		}
+
+		constexpr bool empty() const noexcept {
+			return m_size == 0;
+		}
+
+		constexpr const_iterator begin() const noexcept {
+			return m_data;
+		}
+
+		constexpr const_iterator end() const noexcept {
+			return m_data + m_size;
+		}
+
+		constexpr const char &operator[](std::size_t idx) const noexcept {
+			return m_data[idx];
+		}
+
+		constexpr const char &front() const noexcept {
+			return m_data[0];
+		}
+
+		String_View substr(std::size_t pos, std::size_t count = std::string::npos) const noexcept {
+			pos = pos < m_size ? pos : m_size;
+			return String_View{m_data + pos, count < m_size - pos ? count : m_size - pos};
+		}
+
+		std::size_t find(char c, std::size_t pos = 0) const noexcept {
+			for (; pos < m_size; ++pos) {
+				if (m_data[pos] == c)
+					return pos;
+			}
+			return std::string::npos;
+		}
+
+		explicit operator std::string() const {
+			return std::string(m_data, m_size);
+		}
+
+		friend bool operator==(String_View lhs, String_View rhs) noexcept {
+			return lhs.m_size == rhs.m_size && (lhs.m_size == 0 || std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size) == 0);
+		}
+
+		friend bool operator!=(String_View lhs, String_View rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+		friend std::ostream &operator<<(std::ostream &out, String_View str) {
+			return out.write(str.m_data, str.m_size);
+		}
+
+	private:
+		const char *m_data;
+		std::size_t m_size;
+	};
+#endif /* __cplusplus >= 201703L */
+
+	/**
+	 * FNV-1a hash functor for String_View keys.
+	 */
+	struct String_View_Hash {
+		static constexpr std::size_t OFFSET_BASIS{sizeof(std::size_t) > 4 ? static_cast<std::size_t>(14695981039346656037ull) : 2166136261u};
+		static constexpr std::size_t PRIME{sizeof(std::size_t) > 4 ? static_cast<std::size_t>(1099511628211ull) : 16777619u};
+
+		std::size_t operator()(String_View str) const noexcept {
+			std::size_t hash{OFFSET_BASIS};
+			for (auto c : str)
+				hash = (hash ^ static_cast<unsigned char>(c)) * PRIME;
+			return hash;
+		}
+
+		/**
+		 * Compute the hash of a null-terminated string at compile time.
+		 */
+		static constexpr std::size_t hash(const char *str, std::size_t hash = OFFSET_BASIS) noexcept {
+			return *str ? String_View_Hash::hash(str + 1, (hash ^ static_cast<unsigned char>(*str)) * PRIME) : hash;
+		}
+	};
+
+	/**
+	 * String_View key that carries its String_View_Hash, so that a hash computed
+	 * ahead of time, e.g. by String_View_Hash::hash() at compile time, is not
+	 * computed again when the key is inserted.
+	 */
+	struct Hashed_String_View {
+		/**
+		 * Hash functor that returns the carried hash.
+		 */
+		struct Hash {
+			std::size_t operator()(const Hashed_String_View &key) const noexcept {
+				return key.hash;
+			}
+		};
+
+		String_View str;
+		std::size_t hash;
+
+		Hashed_String_View(String_View str) noexcept
+				: str{str}, hash{String_View_Hash{}(str)} { }
+
+		Hashed_String_View(const std::string &str) noexcept
+				: Hashed_String_View{String_View{str}} { }
+
+		Hashed_String_View(const char *str) noexcept
+				: Hashed_String_View{String_View{str}} { }
+
+		/**
+		 * @param str   string to refer to
+		 * @param hash  String_View_Hash of @a str
+		 */
+		constexpr Hashed_String_View(String_View str, std::size_t hash) noexcept
+				: str{str}, hash{hash} { }
+
+		friend bool operator==(const Hashed_String_View &lhs, const Hashed_String_View &rhs) noexcept {
+			return lhs.hash == rhs.hash && lhs.str == rhs.str;
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_STRING_VIEW_H_ */
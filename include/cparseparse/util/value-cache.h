@@ -0,0 +1,199 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_VALUE_CACHE_H_
+#define CPARSEPARSE_UTIL_VALUE_CACHE_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * @return a key that uniquely identifies type @a T without requiring RTTI
+	 */
+	template<class T>
+	const void *type_key() noexcept {
+		static const char key{};
+		return &key;
+	}
+
+	/**
+	 * Cache of argument values that have already been converted, holding one list
+	 * of converted values per requested type.
+	 *
+	 * Storage for each type is kept when the cache is invalidated, so that
+	 * re-populating it after a later parse reuses the existing capacity. Each
+	 * list is constructed in place in its slot rather than allocated separately.
+	 */
+	class Value_Cache {
+	public:
+
+		/**
+		 * Look up the cached values converted as type @a T.
+		 *
+		 * @tparam T  converted value type
+		 * @return a pointer to the cached values, or @a nullptr if no valid values are
+		 *         cached for type @a T
+		 */
+		template<class T>
+		const std::vector<T> *find() const noexcept {
+			for (const auto &slot : m_slots) {
+				if (slot.key == type_key<T>())
+					return slot.valid ? &slot.template values<T>() : nullptr;
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Convert and cache @a count values as type @a T.
+		 *
+		 * If any conversion throws, no values are cached for type @a T.
+		 *
+		 * @tparam T        converted value type
+		 * @param count     number of values
+		 * @param convert   callable returning the value at the given index converted
+		 *                  as type @a T
+		 * @return the cached values
+		 */
+		template<class T, class Convert_Func>
+		const std::vector<T> &store(std::size_t count, Convert_Func &&convert) {
+			auto &slot = slot_for<T>();
+			auto &values = slot.template values<T>();
+			slot.valid = false;
+			values.clear();
+			values.reserve(count);
+			for (std::size_t i = 0; i < count; ++i)
+				values.push_back(convert(i));
+			slot.valid = true;
+			return values;
+		}
+
+		/**
+		 * @return the number of bytes allocated by the cache, including the storage
+		 *         kept for invalidated values
+		 */
+		std::size_t memory_footprint() const noexcept {
+			std::size_t bytes{m_slots.capacity() * sizeof(Slot)};
+			for (const auto &slot : m_slots)
+				bytes += slot.footprint();
+			return bytes;
+		}
+
+		/**
+		 * Invalidate all cached values, keeping their storage.
+		 */
+		void invalidate() noexcept {
+			for (auto &slot : m_slots)
+				slot.valid = false;
+		}
+
+	private:
+
+		/**
+		 * Raw storage large enough for a @a std::vector of any element type.
+		 */
+		using Storage = typename std::aligned_storage<(sizeof(std::vector<bool>) > sizeof(std::vector<char>) ? sizeof(std::vector<bool>) : sizeof(std::vector<char>)),
+				alignof(std::vector<char>)>::type;
+
+		template<class T>
+		struct Type_Tag { };
+
+		/**
+		 * Type-erased list of values of a single type, held in the slot's own storage.
+		 */
+		class Slot {
+		public:
+			const void *key;
+			bool valid{false};
+
+			template<class T>
+			explicit Slot(Type_Tag<T>) noexcept
+					: key{type_key<T>()},
+					  m_manage{&manage<T>},
+					  m_footprint{&footprint<T>} {
+				static_assert(sizeof(std::vector<T>) <= sizeof(Storage) && alignof(std::vector<T>) <= alignof(Storage),
+						"value list does not fit in the slot storage");
+				new (&m_storage) std::vector<T>{};
+			}
+
+			Slot(Slot &&other) noexcept
+					: key{other.key},
+					  valid{other.valid},
+					  m_manage{other.m_manage},
+					  m_footprint{other.m_footprint} {
+				m_manage(&other.m_storage, &m_storage);
+			}
+
+			~Slot() {
+				m_manage(&m_storage, nullptr);
+			}
+
+			Slot(const Slot &) = delete;
+			Slot &operator=(const Slot &) = delete;
+			Slot &operator=(Slot &&) = delete;
+
+			/**
+			 * @return the number of bytes allocated by the value list
+			 */
+			std::size_t footprint() const noexcept {
+				return m_footprint(&m_storage);
+			}
+
+			template<class T>
+			std::vector<T> &values() noexcept {
+				return *reinterpret_cast<std::vector<T> *>(&m_storage);
+			}
+
+			template<class T>
+			const std::vector<T> &values() const noexcept {
+				return *reinterpret_cast<const std::vector<T> *>(&m_storage);
+			}
+
+		private:
+			Storage m_storage;
+			void (*m_manage)(Storage *, Storage *);  // Moves the list into the second storage, or destroys it if that is nullptr
+			std::size_t (*m_footprint)(const Storage *);
+
+			template<class T>
+			static void manage(Storage *from, Storage *to) noexcept {
+				auto &values = *reinterpret_cast<std::vector<T> *>(from);
+				if (to)
+					new (to) std::vector<T>{std::move(values)};
+				else
+					values.~vector();
+			}
+
+			template<class T>
+			static std::size_t footprint(const Storage *storage) noexcept {
+				const auto capacity = reinterpret_cast<const std::vector<T> *>(storage)->capacity();
+				return std::is_same<T, bool>::value ? (capacity + 7) / 8 : capacity * sizeof(T);
+			}
+		};
+
+		std::vector<Slot> m_slots;
+
+		/**
+		 * Find or create the slot holding values of type @a T.
+		 */
+		template<class T>
+		Slot &slot_for() {
+			for (auto &slot : m_slots) {
+				if (slot.key == type_key<T>())
+					return slot;
+			}
+			m_slots.emplace_back(Type_Tag<T>{});
+			return m_slots.back();
+		}
+
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_VALUE_CACHE_H_ */
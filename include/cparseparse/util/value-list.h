@@ -0,0 +1,188 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_UTIL_VALUE_LIST_H_
+#define CPARSEPARSE_UTIL_VALUE_LIST_H_
+
+#include "cparseparse/util/memory-resource.h"
+#include "cparseparse/util/string-view.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Non-owning, indexable range of argument values, held either as an array of
+	 * views or as a character buffer with the end offset of each value.
+	 */
+	class Value_Range {
+	public:
+
+		/**
+		 * Refer to an array of value views.
+		 */
+		Value_Range(const String_View *views, std::size_t count) noexcept
+				: m_views{views},
+				  m_chars{nullptr},
+				  m_ends{nullptr},
+				  m_count{count} { }
+
+		/**
+		 * Refer to values stored back to back in @a chars, each followed by a null
+		 * character, where @a ends holds the offset just past each terminator.
+		 */
+		Value_Range(const char *chars, const std::uint32_t *ends, std::size_t count) noexcept
+				: m_views{nullptr},
+				  m_chars{chars},
+				  m_ends{ends},
+				  m_count{count} { }
+
+		std::size_t size() const noexcept {
+			return m_count;
+		}
+
+		bool empty() const noexcept {
+			return m_count == 0;
+		}
+
+		String_View operator[](std::size_t idx) const noexcept {
+			if (m_views)
+				return m_views[idx];
+			const std::uint32_t first{idx ? m_ends[idx - 1] : 0};
+			return String_View{m_chars + first, m_ends[idx] - first - 1};
+		}
+
+		String_View back() const noexcept {
+			return (*this)[m_count - 1];
+		}
+
+	private:
+		const String_View *m_views;
+		const char *m_chars;
+		const std::uint32_t *m_ends;
+		std::size_t m_count;
+	};
+
+	/**
+	 * Values of an optional argument.
+	 *
+	 * By default each value is a view, which refers to the parser's value storage
+	 * or to argv. In compact mode, the characters of every value are instead
+	 * copied into a single buffer owned by the list, and each value is recorded
+	 * only by a 4-byte end offset, which suits very long lists of short values.
+	 */
+	class Value_List {
+	public:
+
+		explicit Value_List(Memory_Resource *resource = default_resource())
+				: m_views{Resource_Allocator<String_View>{resource}},
+				  m_chars{Resource_Allocator<char>{resource}},
+				  m_ends{Resource_Allocator<std::uint32_t>{resource}} { }
+
+		/**
+		 * @return true if the values are stored in compact mode, or false otherwise
+		 */
+		bool compact() const noexcept {
+			return m_compact;
+		}
+
+		/**
+		 * Select compact or view storage, clearing any values and releasing the
+		 * storage of the mode no longer in use.
+		 */
+		void set_compact(bool compact) {
+			clear();
+			m_compact = compact;
+			if (m_compact)
+				decltype(m_views){m_views.get_allocator()}.swap(m_views);
+			else {
+				decltype(m_chars){m_chars.get_allocator()}.swap(m_chars);
+				decltype(m_ends){m_ends.get_allocator()}.swap(m_ends);
+			}
+		}
+
+		std::size_t size() const noexcept {
+			return m_compact ? m_ends.size() : m_views.size();
+		}
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		String_View operator[](std::size_t idx) const noexcept {
+			return range()[idx];
+		}
+
+		/**
+		 * @return a range referring to the values, which is invalidated by the next
+		 *         change to the list
+		 */
+		Value_Range range() const noexcept {
+			if (m_compact)
+				return Value_Range{m_chars.data(), m_ends.data(), m_ends.size()};
+			return Value_Range{m_views.data(), m_views.size()};
+		}
+
+		/**
+		 * @return the value views, which are only used when not in compact mode
+		 */
+		std::vector<String_View, Resource_Allocator<String_View>> &views() noexcept {
+			return m_views;
+		}
+
+		/**
+		 * Append a value, copying its characters in compact mode.
+		 *
+		 * @throw std::length_error  if the values of a compact list would exceed 4 GiB
+		 */
+		void push_back(String_View value) {
+			if (!m_compact) {
+				m_views.push_back(value);
+				return;
+			}
+			if (value.size() >= std::numeric_limits<std::uint32_t>::max() - m_chars.size())
+				throw std::length_error{"compact argument values exceed 4 GiB"};
+			const auto size = m_chars.size();
+			try {
+				m_chars.insert(m_chars.end(), value.begin(), value.end());
+				m_chars.push_back('\0');
+				m_ends.push_back(static_cast<std::uint32_t>(m_chars.size()));
+			} catch (...) {
+				m_chars.resize(size);
+				throw;
+			}
+		}
+
+		/**
+		 * Remove every value, keeping the allocated storage.
+		 */
+		void clear() noexcept {
+			m_views.clear();
+			m_chars.clear();
+			m_ends.clear();
+		}
+
+		/**
+		 * @return the number of bytes allocated by the list, excluding the characters
+		 *         of values that are stored as views
+		 */
+		std::size_t memory_footprint() const noexcept {
+			return m_views.capacity() * sizeof(String_View) + m_chars.capacity() + m_ends.capacity() * sizeof(std::uint32_t);
+		}
+
+	private:
+		std::vector<String_View, Resource_Allocator<String_View>> m_views;
+		std::vector<char, Resource_Allocator<char>> m_chars;  // Compact values, each followed by '\0'
+		std::vector<std::uint32_t, Resource_Allocator<std::uint32_t>> m_ends;  // Offset past each compact value's '\0'
+		bool m_compact{false};
+	};
+
+}
+
+#endif /* CPARSEPARSE_UTIL_VALUE_LIST_H_ */
@@ -0,0 +1,68 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_VALIDATION_ERROR_H_
+#define CPARSEPARSE_VALIDATION_ERROR_H_
+
+#include "cparseparse/util/errstr.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace cpparse {
+
+	/**
+	 * Value rejected by a validator set with Argument_Info::validator().
+	 */
+	struct Validation_Failure {
+		std::string name;     // Argument name
+		std::string value;    // Rejected value
+		std::string message;  // Reason returned by the validator
+	};
+
+	/**
+	 * Error thrown by Argument_Parser::parse_args() when validators reject any of
+	 * the values, reporting every rejected value rather than only the first.
+	 *
+	 * what() holds one line per failure, in the order in which the arguments were
+	 * added and their values given.
+	 */
+	class Validation_Error : public std::runtime_error {
+	public:
+
+		/**
+		 * @param script_name  script name prefixed to each line of the report
+		 * @param failures     rejected values
+		 */
+		Validation_Error(const std::string &script_name, std::vector<Validation_Failure> failures)
+				: std::runtime_error{report(script_name, failures)},
+				  m_failures{std::make_shared<const std::vector<Validation_Failure>>(std::move(failures))} { }
+
+		/**
+		 * @return the rejected values
+		 */
+		const std::vector<Validation_Failure> &failures() const noexcept {
+			return *m_failures;
+		}
+
+	private:
+		std::shared_ptr<const std::vector<Validation_Failure>> m_failures;  // Shared so that copying the error does not throw
+
+		static std::string report(const std::string &script_name, const std::vector<Validation_Failure> &failures) {
+			std::string text;
+			for (const auto &failure : failures) {
+				if (!text.empty())
+					text += '\n';
+				text += script_errstr(script_name, "invalid value '", failure.value, "' for '", failure.name, "': ", failure.message);
+			}
+			return text;
+		}
+	};
+
+}
+
+#endif /* CPARSEPARSE_VALIDATION_ERROR_H_ */
@@ -0,0 +1,20 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_LIBRARY
+#error "The cparseparse library must be compiled with CPARSEPARSE_LIBRARY defined"
+#endif /* CPARSEPARSE_LIBRARY */
+
+#include "cparseparse/argument-parser.h"
+#include "cparseparse/impl/argument-parser.h"
+
+namespace cpparse {
+
+#define CPARSEPARSE_DEFINE_VALUE_TYPE(T) CPARSEPARSE_INSTANTIATE_VALUE_TYPE(, T)
+	CPARSEPARSE_FOR_EACH_VALUE_TYPE(CPARSEPARSE_DEFINE_VALUE_TYPE)
+#undef CPARSEPARSE_DEFINE_VALUE_TYPE
+
+}
@@ -5,7 +5,13 @@
  */
 
 #include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
 #include <catch2/catch.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
 
 using namespace Catch::Matchers;
 using namespace cpparse;
@@ -18,12 +24,6 @@ static bool help_contains(Argument_Parser &parser, const std::string &str) {
 	return out.str().find(str) != std::string::npos;
 }
 
-static void invoke_parse_args(Argument_Parser &parser, std::vector<const char *> args) {
-	int argc = args.size();
-	auto argv = args.data();
-	parser.parse_args(argc, argv);
-};
-
 TEST_CASE("Argument_Parser help text") {
 	static const std::string desc_str{"program descrition"};
 	static const std::string pos_help{"some positional argument"};
@@ -58,6 +58,44 @@ TEST_CASE("Argument_Parser help text") {
 	REQUIRE(help_contains(parser, help_text));
 }
 
+TEST_CASE("Argument_Parser cached help text") {
+	Argument_Parser parser;
+	parser.set_description("desc");
+	parser.add_positional("input").help("input file");
+	auto &output = parser.add_optional("-o", "--output", Opt_Type::SINGLE).help("output file");
+	auto &verbose = parser.add_optional("--verbose", Opt_Type::FLAG);
+	invoke_parse_args(parser, {"test-program", "in.txt"});
+	REQUIRE(!help_contains(parser, "be verbose"));
+
+	verbose.help("be verbose");
+	std::ostringstream out;
+	parser.print_help(out);
+	REQUIRE(out.str() ==
+			"Usage: test-program [options] <input>\n"
+			"\n"
+			"  desc\n"
+			"\n"
+			"Positional arguments:\n"
+			"  input             input file\n"
+			"\n"
+			"Options:\n"
+			"  -h, --help                  display this help text\n"
+			"  -o, --output OUTPUT         output file\n"
+			"  --verbose                   be verbose\n");
+
+	out.str("");
+	parser.print_usage(out);
+	REQUIRE(out.str() == "Usage: test-program [options] <input>\n");
+
+	output.help("destination file");
+	REQUIRE(help_contains(parser, "  -o, --output OUTPUT         destination file\n"));
+	parser.add_optional("-x", "--exclude", Opt_Type::APPEND);
+	REQUIRE(help_contains(parser, "  -x, --exclude EXCLUDE       \n"));
+	invoke_parse_args(parser, {"other-program", "in.txt"});
+	REQUIRE(help_contains(parser, "Usage: other-program [options] <input>\n"));
+	invoke_parse_args(parser, {"test-program", "in.txt"});
+}
+
 TEST_CASE("Argument_Parser help handler") {
 	bool invoked{false};
 	Argument_Parser parser{};
@@ -271,3 +309,449 @@ TEST_CASE("Argument_Parser arg()") {
 		REQUIRE(parser.arg<std::string>("sarg") == "abc123");
 	}
 }
+
+TEST_CASE("Argument_Parser zero-copy values") {
+	char pos_value[] = "pos-value";
+	char opt_value[] = "opt-value";
+	std::vector<const char *> args{"test-program", pos_value, "--opt", opt_value, "--opt", "123"};
+
+	SECTION("Copied") {
+		Argument_Parser parser;
+		auto &pos = parser.add_positional("pos");
+		auto &opt = parser.add_optional("--opt", Opt_Type::APPEND);
+		invoke_parse_args(parser, args);
+		REQUIRE(pos.as_type<String_View>().data() != pos_value);
+		REQUIRE(opt.as_type_at<String_View>(0).data() != opt_value);
+
+		pos_value[0] = opt_value[0] = 'X';
+		REQUIRE(pos.as_type<std::string>() == "pos-value");
+		REQUIRE(opt.as_type_at<std::string>(0) == "opt-value");
+		REQUIRE(opt.as_type_at<int>(1) == 123);
+	}
+	SECTION("Views into argv") {
+		Argument_Parser parser{Argument_Parser::Options{}.zero_copy(true)};
+		auto &pos = parser.add_positional("pos");
+		auto &opt = parser.add_optional("--opt", Opt_Type::APPEND);
+		invoke_parse_args(parser, args);
+		REQUIRE(pos.as_type<String_View>().data() == pos_value);
+		REQUIRE(opt.as_type_at<String_View>(0).data() == opt_value);
+		REQUIRE(opt.as_type_at<String_View>(0) == "opt-value");
+		REQUIRE(opt.as_type_at<int>(1) == 123);
+		REQUIRE(parser.arg<std::string>("pos") == "pos-value");
+	}
+}
+
+TEST_CASE("Argument_Parser many arguments") {
+	Argument_Parser parser{Argument_Parser::Options{}.auto_help(false)};
+	std::vector<Optional_Info *> optionals;
+	for (char c = 'a'; c <= 'z'; ++c)
+		optionals.push_back(&parser.add_optional(std::string{"-"} + c, std::string{"--opt-"} + c, Opt_Type::SINGLE));
+	for (int i = 0; i < 200; ++i)
+		optionals.push_back(&parser.add_optional("--long-" + std::to_string(i), Opt_Type::APPEND));
+	auto &pos = parser.add_positional("pos");
+
+	invoke_parse_args(parser, {"test-program", "-q", "17", "--long-150", "x", "value", "--opt-z", "26", "--long-150", "y"});
+	REQUIRE(&parser.add_optional("--late") != optionals.front());
+	REQUIRE(optionals['q' - 'a']->as_type<int>() == 17);
+	REQUIRE(optionals['z' - 'a']->as_type<int>() == 26);
+	REQUIRE(parser.arg<int>("opt-q") == 17);
+	REQUIRE(parser.args<std::string>("long-150") == std::vector<std::string>{"x", "y"});
+	REQUIRE(parser.arg_count("long-149") == 0);
+	REQUIRE(pos.as_type<std::string>() == "value");
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "-A"}), StartsWith("test-program: invalid flag '-A'"));
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "--pos"}), StartsWith("test-program: invalid option 'pos'"));
+}
+
+TEST_CASE("Argument_Parser cached values") {
+	Argument_Parser parser;
+	auto &pos = parser.add_positional("pos");
+	auto &opt = parser.add_optional("--opt", Opt_Type::APPEND);
+	parser.add_optional("--single", Opt_Type::SINGLE);
+	invoke_parse_args(parser, {"test-program", "42", "--opt", "1", "--opt", "-2", "--single", "abc"});
+
+	pos.cache<int>();
+	REQUIRE(pos.as_type<int>() == 42);
+	REQUIRE(pos.as_type<std::string>() == "42");
+	opt.cache<long>().cache<double>();
+	REQUIRE(opt.as_type_all<long>() == std::vector<long>{1, -2});
+	REQUIRE(opt.as_type_at<double>(1) == -2.0);
+	REQUIRE_THROWS_WITH(opt.as_type_at<long>(2), EndsWith("index 2 is out of range for 'opt'"));
+	REQUIRE_THROWS_WITH(opt.cache<unsigned int>(), Contains("must be in range"));
+	REQUIRE_THROWS_WITH(parser.cache_arg<int>("single"), EndsWith("must be of integral type"));
+	REQUIRE_THROWS_WITH(parser.cache_arg<int>("unknown"), Contains("no argument by the name"));
+	parser.cache_arg<int>("opt");
+	REQUIRE(parser.arg_at<int>("opt", 1) == -2);
+
+	invoke_parse_args(parser, {"test-program", "7", "--opt", "5"});
+	REQUIRE(pos.as_type<int>() == 7);
+	REQUIRE(opt.as_type_all<long>() == std::vector<long>{5});
+	REQUIRE(parser.arg<int>("opt") == 5);
+}
+
+TEST_CASE("Argument_Parser bulk conversion") {
+	Argument_Parser parser;
+	auto &ids = parser.add_optional("--id", Opt_Type::APPEND);
+	invoke_parse_args(parser, {"test-program", "--id", "1", "--id", "2", "--id", "x3", "--id", "-4"});
+
+	std::vector<int> values;
+	auto result = ids.as_type_into<int>(std::back_inserter(values));
+	REQUIRE(!result);
+	REQUIRE(result.count == 2);
+	REQUIRE(result.status == Convert_Status::INVALID);
+	REQUIRE(values == std::vector<int>{1, 2});
+
+	unsigned int buffer[2];
+	result = ids.as_type_into<unsigned int>(buffer, 2);
+	REQUIRE(result);
+	REQUIRE(result.count == 2);
+	REQUIRE(buffer[1] == 2);
+
+	std::vector<std::string> strings;
+	result = parser.args_into<std::string>("id", std::back_inserter(strings));
+	REQUIRE(result);
+	REQUIRE(result.count == 4);
+	REQUIRE(strings.back() == "-4");
+
+	invoke_parse_args(parser, {"test-program", "--id", "7", "--id", "-8"});
+	ids.cache<long>();
+	std::vector<long> cached(2);
+	REQUIRE(parser.args_into<long>("id", cached.begin()));
+	REQUIRE(cached == std::vector<long>{7, -8});
+	REQUIRE(ids.as_type_into<unsigned int>(buffer, 2).status == Convert_Status::OUT_OF_RANGE);
+	REQUIRE_THROWS_WITH(parser.args_into<int>("unknown", buffer), Contains("no optional argument by the name"));
+}
+
+namespace {
+
+	/**
+	 * Memory resource that counts the allocations passed through to the default
+	 * resource.
+	 */
+	class Counting_Resource : public Memory_Resource {
+	public:
+		std::size_t allocations{0};
+		std::size_t outstanding{0};
+
+	private:
+		void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++allocations;
+			++outstanding;
+			return default_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+			--outstanding;
+			default_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const Memory_Resource &other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+}
+
+TEST_CASE("Argument_Parser memory resource") {
+	const std::vector<const char *> args{"test-program", "pos-value", "extra", "--opt", "1", "--opt", "2", "-f"};
+	Counting_Resource counter;
+
+	SECTION("Parser storage") {
+		{
+			Argument_Parser parser{Argument_Parser::Options{}.memory_resource(&counter)};
+			parser.add_positional("pos");
+			parser.add_optional("--opt", Opt_Type::APPEND);
+			parser.add_optional("-f", "--flag", Opt_Type::FLAG);
+			invoke_parse_args(parser, args);
+			REQUIRE(counter.allocations > 0);
+			REQUIRE(parser.arg<std::string>("pos") == "pos-value");
+			REQUIRE(parser.args<int>("opt") == std::vector<int>{1, 2});
+			REQUIRE(parser.arg<bool>("flag"));
+
+			const auto allocations = counter.allocations;
+			invoke_parse_args(parser, args);
+			REQUIRE(counter.allocations == allocations);
+			REQUIRE(parser.arg_at<int>("opt", 1) == 2);
+
+			Argument_Parser moved{std::move(parser)};
+			REQUIRE(moved.arg<std::string>("pos") == "pos-value");
+		}
+		REQUIRE(counter.outstanding == 0);
+	}
+	SECTION("Monotonic arena") {
+		{
+			Monotonic_Buffer_Resource arena{4096, &counter};
+			Argument_Parser parser{Argument_Parser::Options{}.memory_resource(&arena)};
+			parser.add_positional("pos");
+			parser.add_optional("--opt", Opt_Type::APPEND);
+			parser.add_optional("-f", "--flag", Opt_Type::FLAG);
+			invoke_parse_args(parser, args);
+			REQUIRE(counter.allocations == 1);
+			REQUIRE(parser.arg<std::string>("pos") == "pos-value");
+			REQUIRE(parser.args<int>("opt") == std::vector<int>{1, 2});
+		}
+		REQUIRE(counter.outstanding == 0);
+	}
+}
+
+TEST_CASE("Argument_Parser subcommands") {
+	Argument_Parser parser;
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	int build_defined{0}, clean_defined{0};
+	parser.add_subcommand("build", [&build_defined](Argument_Parser &build) {
+		++build_defined;
+		build.add_positional("target");
+		build.add_optional("-j", "--jobs", Opt_Type::SINGLE);
+	}).help("build a target");
+	parser.add_subcommand("clean", [&clean_defined](Argument_Parser &clean) {
+		++clean_defined;
+		clean.add_optional("--all", Opt_Type::FLAG);
+	});
+	REQUIRE_THROWS_WITH(parser.add_subcommand("build", [](Argument_Parser &) { }), Contains("duplicate subcommand name 'build'"));
+	REQUIRE_THROWS_WITH(parser.add_subcommand("-x", [](Argument_Parser &) { }), Contains("invalid subcommand name '-x'"));
+	/* No script name is known before the first parse, even after other parsers have parsed */
+	REQUIRE(help_contains(parser, "Usage:  [options] <subcommand> ...\n"));
+	REQUIRE(help_contains(parser, "Subcommands:\n  build             build a target\n  clean"));
+
+	std::vector<const char *> args{"test-program", "-v", "build", "-j", "4", "all", "extra"};
+	int argc = args.size();
+	auto argv = args.data();
+	parser.parse_args(argc, argv);
+	REQUIRE(build_defined == 1);
+	REQUIRE(clean_defined == 0);
+	REQUIRE(parser.arg<bool>("verbose"));
+	REQUIRE(parser.has_subcommand());
+	REQUIRE(parser.subcommand() == "build");
+	REQUIRE(parser.subcommand_parser().arg<int>("jobs") == 4);
+	REQUIRE(parser.subcommand_parser().arg<std::string>("target") == "all");
+	REQUIRE(argc == 2);
+	REQUIRE(argv[1] == std::string{"extra"});
+	REQUIRE(help_contains(parser.subcommand_parser(), "Usage: test-program build [options] <target>\n"));
+
+	invoke_parse_args(parser, {"test-program", "build", "lib"});
+	REQUIRE(build_defined == 1);
+	REQUIRE(!parser.arg<bool>("verbose"));
+	REQUIRE(parser.subcommand_parser().arg<std::string>("target") == "lib");
+	REQUIRE(parser.subcommand_parser().arg<int>("jobs", 1) == 1);
+
+	invoke_parse_args(parser, {"test-program", "clean", "--all"});
+	REQUIRE(clean_defined == 1);
+	REQUIRE(parser.subcommand() == "clean");
+	REQUIRE(parser.subcommand_parser().arg<bool>("all"));
+
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "-v"}), StartsWith("test-program: requires a subcommand"));
+	REQUIRE(!parser.has_subcommand());
+	REQUIRE_THROWS_WITH(parser.subcommand_parser(), Contains("no subcommand was selected"));
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "install"}), StartsWith("test-program: invalid subcommand 'install'"));
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "-v", "build"}), StartsWith("test-program build: requires positional argument 'target'"));
+	REQUIRE(!parser.has_subcommand());
+	REQUIRE(!parser.has_arg("verbose"));
+	invoke_parse_args(parser, {"test-program", "clean"});
+}
+
+TEST_CASE("Argument_Parser reset and re-parse") {
+	Counting_Resource counter;
+	Argument_Parser parser{Argument_Parser::Options{}.memory_resource(&counter)};
+	auto &pos = parser.add_positional("pos");
+	auto &opt = parser.add_optional("--opt", Opt_Type::APPEND);
+	parser.add_subcommand("run", [](Argument_Parser &run) {
+		run.add_optional("--count", Opt_Type::APPEND);
+	});
+	parser.add_subcommand("stop", [](Argument_Parser &stop) {
+		stop.add_positional("name");
+	});
+
+	const std::vector<std::vector<const char *>> commands{
+		{"server", "a", "--opt", "1", "--opt", "2", "run", "--count", "3", "--count", "4"},
+		{"server", "b", "stop", "worker-1"},
+		{"server", "c", "--opt", "5", "run"},
+	};
+	for (const auto &command : commands)
+		invoke_parse_args(parser, command);
+
+	const auto allocations = counter.allocations;
+	for (int round = 0; round < 3; ++round) {
+		for (const auto &command : commands) {
+			parser.reset();
+			REQUIRE(!parser.has_arg("opt"));
+			REQUIRE(!parser.has_subcommand());
+			invoke_parse_args(parser, command);
+		}
+		REQUIRE(parser.subcommand() == "run");
+		REQUIRE(pos.as_type<std::string>() == "c");
+		REQUIRE(opt.as_type_all<int>() == std::vector<int>{5});
+		REQUIRE(parser.subcommand_parser().arg_count("count") == 0);
+	}
+	REQUIRE(counter.allocations == allocations);
+
+	parser.reset();
+	REQUIRE(pos.as_type<std::string>().empty());
+	REQUIRE(opt.count() == 0);
+}
+
+TEST_CASE("Argument_Parser value callbacks") {
+	Argument_Parser parser;
+	std::vector<int> ids;
+	std::vector<std::string> names;
+	parser.add_optional("-i", "--id", Opt_Type::APPEND).on_value<int>([&ids](int id) { ids.push_back(id); });
+	parser.add_optional("--name", Opt_Type::APPEND).on_value<String_View>([&names](String_View name) { names.emplace_back(name); });
+	parser.add_optional("--other", Opt_Type::APPEND);
+	REQUIRE_THROWS_WITH(parser.add_optional("--single").on_value<int>([](int) { }), Contains("requires an append-type argument"));
+
+	invoke_parse_args(parser, {"test-program", "-i", "1", "--other", "x", "--name", "a", "--id", "2", "--name", "b"});
+	REQUIRE(ids == std::vector<int>{1, 2});
+	REQUIRE(names == std::vector<std::string>{"a", "b"});
+	REQUIRE(!parser.has_arg("id"));
+	REQUIRE(parser.arg_count("id") == 0);
+	REQUIRE(parser.args<std::string>("other") == std::vector<std::string>{"x"});
+	REQUIRE_THROWS_WITH(parser.arg_at<int>("id", 0), Contains("values of 'id' are passed to its callback and not stored"));
+	REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"test-program", "-i", "3", "-i", "x"}), Equals("test-program: 'id' must be of integral type"));
+	REQUIRE(ids == std::vector<int>{1, 2, 3});
+
+	ids.clear();
+	const char *args[] = {"other-program", "--id", "4", "--other", "y", "--id", "z"};
+	const auto result = parser.parse(5, args);
+	REQUIRE(ids == std::vector<int>{4});
+	REQUIRE(result.arg_count("id") == 0);
+	REQUIRE(result.arg<std::string>("other") == "y");
+	REQUIRE_THROWS_WITH(parser.parse(7, args), Equals("other-program: 'id' must be of integral type"));
+}
+
+TEST_CASE("Argument_Parser fallback layers") {
+	const std::string config_path{"cparseparse-test-config"};
+	std::ofstream{config_path} << "# comment\n"
+			"\n"
+			"  threads = 4\n"
+			"name = \"from config\"\n"
+			"tag = a\n"
+			"tag=b\n"
+			"verbose = yes\n"
+			"level = 2\n";
+	setenv("TEST_APP_LEVEL", "3", 1);
+	setenv("TEST_APP_THREADS", "", 1);
+	setenv("TEST_OUTPUT", "out.txt", 1);
+	setenv("TEST_APP_HELP", "1", 1);
+
+	Argument_Parser parser{Argument_Parser::Options{}.env_prefix("TEST_APP_")};
+	parser.add_optional("--threads");
+	parser.add_optional("--name");
+	parser.add_optional("--tag", Opt_Type::APPEND);
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("--level");
+	parser.add_optional("-o", "--output").env("TEST_OUTPUT");
+	parser.add_optional("--missing");
+	parser.load_config(config_path);
+	parser.load_environment();
+
+	invoke_parse_args(parser, {"test-program", "--name", "from argv"});
+	REQUIRE(parser.arg<std::string>("name") == "from argv");
+	REQUIRE(parser.arg<std::string>("threads", "default") == "");
+	REQUIRE(parser.args<std::string>("tag") == std::vector<std::string>{"a", "b"});
+	REQUIRE(parser.arg<bool>("verbose"));
+	REQUIRE(parser.arg<int>("level") == 3);
+	REQUIRE(parser.arg<std::string>("output") == "out.txt");
+	REQUIRE(parser.arg<std::string>("missing", "default") == "default");
+
+	const char *args[] = {"other-program", "--tag", "c", "--level", "5"};
+	const auto result = parser.parse(5, args);
+	REQUIRE(result.arg<std::string>("name") == "from config");
+	REQUIRE(result.args<std::string>("tag") == std::vector<std::string>{"c"});
+	REQUIRE(result.arg<int>("level") == 5);
+
+	SECTION("Later files replace earlier ones") {
+		std::ofstream{config_path} << "tag = d\nname = second\n";
+		parser.load_config(config_path);
+		invoke_parse_args(parser, {"test-program"});
+		REQUIRE(parser.args<std::string>("tag") == std::vector<std::string>{"d"});
+		REQUIRE(parser.arg<std::string>("name") == "second");
+		REQUIRE(parser.arg<int>("level") == 3);
+	}
+	SECTION("Clearing before a reload") {
+		unsetenv("TEST_APP_LEVEL");
+		parser.clear_fallbacks();
+		invoke_parse_args(parser, {"test-program"});
+		REQUIRE(!parser.has_arg("name"));
+		REQUIRE(!parser.has_arg("level"));
+
+		Counting_Resource counter;
+		Argument_Parser reloading{Argument_Parser::Options{}.memory_resource(&counter)};
+		reloading.add_optional("--name");
+		reloading.add_optional("--tag", Opt_Type::APPEND);
+		std::ofstream{config_path} << "name = " << std::string(1000, 'n') << "\ntag = a\ntag = b\n";
+		std::size_t outstanding{0};
+		for (int i = 0; i < 100; ++i) {
+			reloading.clear_fallbacks();
+			reloading.load_config(config_path);
+			if (i == 0)
+				outstanding = counter.outstanding;
+			REQUIRE(counter.outstanding == outstanding);
+		}
+		invoke_parse_args(reloading, {"test-program"});
+		REQUIRE(reloading.arg<std::string>("name").size() == 1000);
+		REQUIRE(reloading.args<std::string>("tag") == std::vector<std::string>{"a", "b"});
+	}
+	SECTION("Value callbacks") {
+		std::vector<std::string> tags;
+		Argument_Parser streaming;
+		streaming.add_optional("--tag", Opt_Type::APPEND).on_value<std::string>([&tags](std::string tag) { tags.push_back(std::move(tag)); });
+		std::ofstream{config_path} << "tag = a\ntag = b\n";
+		streaming.load_config(config_path);
+		invoke_parse_args(streaming, {"test-program"});
+		REQUIRE(tags == std::vector<std::string>{"a", "b"});
+		invoke_parse_args(streaming, {"test-program", "--tag", "c"});
+		REQUIRE(tags == std::vector<std::string>{"a", "b", "c"});
+		const char *args[] = {"test-program", "--tag", "d"};
+		streaming.parse(3, args);
+		REQUIRE(tags == std::vector<std::string>{"a", "b", "c", "d"});
+	}
+	SECTION("Invalid files") {
+		std::ofstream{config_path} << "threads = 1\nbogus = 2\n";
+		REQUIRE_THROWS_WITH(parser.load_config(config_path), Equals(config_path + ":2: unknown option 'bogus'"));
+		std::ofstream{config_path} << "threads\n";
+		REQUIRE_THROWS_WITH(parser.load_config(config_path), Equals(config_path + ":1: expected 'name = value'"));
+		REQUIRE_THROWS_WITH(parser.load_config("cparseparse-test-missing"), Contains("cannot open file"));
+
+		/* Nothing is loaded from a file with an invalid line */
+		std::ofstream{config_path} << "name = partial\ntag = x\nbogus = 1\n";
+		REQUIRE_THROWS(parser.load_config(config_path));
+		invoke_parse_args(parser, {"test-program"});
+		REQUIRE(parser.arg<std::string>("name") == "from config");
+		REQUIRE(parser.args<std::string>("tag") == std::vector<std::string>{"a", "b"});
+	}
+	SECTION("Flag values") {
+		std::ofstream{config_path} << "name = partial\nverbose = false\n";
+		REQUIRE_THROWS_WITH(parser.load_config(config_path), Equals(config_path + ":2: flag 'verbose' can only be set to true, yes or on"));
+		std::ofstream{config_path} << "verbose = on\n";
+		parser.load_config(config_path);
+
+		setenv("TEST_APP_VERBOSE", "0", 1);
+		setenv("TEST_APP_NAME", "from env", 1);
+		REQUIRE_THROWS_WITH(parser.load_environment(), Equals("TEST_APP_VERBOSE: flag 'verbose' can only be set to true, yes or on"));
+		unsetenv("TEST_APP_VERBOSE");
+		unsetenv("TEST_APP_NAME");
+		invoke_parse_args(parser, {"test-program"});
+		REQUIRE(parser.arg<bool>("verbose"));
+		REQUIRE(parser.arg<std::string>("name") == "from config");
+	}
+	std::remove(config_path.c_str());
+	unsetenv("TEST_APP_LEVEL");
+	unsetenv("TEST_APP_THREADS");
+	unsetenv("TEST_OUTPUT");
+	unsetenv("TEST_APP_HELP");
+}
+
+TEST_CASE("Argument_Parser script names are per parser") {
+	Argument_Parser first, second;
+	first.add_positional("count");
+	second.add_positional("count");
+
+	/* Each thread parses with its own parser, sharing no script name */
+	std::thread other{[&second] { invoke_parse_args(second, {"second-program", "y"}); }};
+	invoke_parse_args(first, {"first-program", "x"});
+	other.join();
+	REQUIRE_THROWS_WITH(first.arg<int>("count"), Equals("first-program: 'count' must be of integral type"));
+	REQUIRE_THROWS_WITH(second.arg<int>("count"), Equals("second-program: 'count' must be of integral type"));
+
+	/* A moved parser keeps reporting its script name */
+	Argument_Parser moved{std::move(first)};
+	REQUIRE_THROWS_WITH(moved.arg<int>("count"), Equals("first-program: 'count' must be of integral type"));
+}
@@ -0,0 +1,111 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/batch-parser.h"
+#include <catch2/catch.hpp>
+#include <mutex>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/**
+ * Job command lines, every third of which is invalid.
+ */
+struct Job_Lines {
+	std::vector<std::string> tokens;
+	std::vector<std::vector<const char *>> lines;
+
+	explicit Job_Lines(std::size_t n_lines) {
+		tokens.reserve(n_lines);
+		for (std::size_t i = 0; i < n_lines; ++i)
+			tokens.push_back(std::to_string(i));
+		for (std::size_t i = 0; i < n_lines; ++i) {
+			switch (i % 3) {
+			case 0:
+				lines.push_back({"job", "--id", tokens[i].c_str(), "input.txt"});
+				break;
+			case 1:
+				lines.push_back(i % 2 ? std::vector<const char *>{"job", "input.txt", "--bogus"} : std::vector<const char *>{"job", "--id"});
+				break;
+			default:
+				lines.push_back({"job", "-v", "input.txt", "--id", tokens[i].c_str(), "--id", "again"});
+				break;
+			}
+		}
+	}
+};
+
+static Argument_Parser job_parser() {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	return parser;
+}
+
+TEST_CASE("Batch_Parser validate()") {
+	const auto parser = job_parser();
+	const Job_Lines jobs{5000};
+	for (unsigned n_threads : {1u, 4u, 0u}) {
+		const Batch_Parser batch{parser, n_threads};
+		REQUIRE(batch.thread_count() >= 1);
+		const auto result = batch.validate(jobs.lines);
+		REQUIRE(result.size() == jobs.lines.size());
+		REQUIRE(result.failure_count() == 1667);
+		REQUIRE(!result.all_valid());
+		std::size_t mismatches{0};
+		for (std::size_t i = 0; i < jobs.lines.size(); ++i) {
+			const auto expected = parser.validate(jobs.lines[i].size(), jobs.lines[i].data());
+			if (result[i].error != expected.error || result[i].index != expected.index)
+				++mismatches;
+		}
+		REQUIRE(mismatches == 0);
+	}
+
+	SECTION("Empty and Command_Line batches") {
+		const Batch_Parser batch{parser, 4};
+		REQUIRE(batch.validate(std::vector<Command_Line>{}).size() == 0);
+
+		const char *valid[] = {"job", "input.txt"};
+		const char *invalid[] = {"job"};
+		const std::vector<Command_Line> lines{{2, valid}, {1, invalid}};
+		const auto result = batch.validate(lines);
+		REQUIRE(result[0]);
+		REQUIRE(result[1].error == Parse_Error::MISSING_POSITIONAL);
+		REQUIRE(result.failure_count() == 1);
+	}
+}
+
+TEST_CASE("Batch_Parser parse()") {
+	const auto parser = job_parser();
+	const Job_Lines jobs{3000};
+	const Batch_Parser batch{parser, 4};
+
+	std::mutex mutex;
+	std::vector<int> ids(jobs.lines.size(), -1);
+	const auto result = batch.parse(jobs.lines, [&](std::size_t line, Parse_Result &&values) {
+		const auto id = values.arg_at<int>("id", 0);
+		std::lock_guard<std::mutex> lock{mutex};
+		ids[line] = id;
+	});
+	REQUIRE(result.failure_count() == 1000);
+	std::vector<int> expected_ids;
+	for (std::size_t i = 0; i < ids.size(); ++i)
+		expected_ids.push_back(i % 3 == 1 ? -1 : static_cast<int>(i));
+	REQUIRE(ids == expected_ids);
+
+	SECTION("Callback exceptions") {
+		REQUIRE_THROWS_WITH(batch.parse(jobs.lines, [](std::size_t line, Parse_Result &&) {
+			if (line == 1500)
+				throw std::runtime_error{"rejected"};
+		}), Equals("rejected"));
+		REQUIRE_THROWS_WITH(batch.parse(jobs.lines, [](std::size_t, Parse_Result &&values) {
+			values.arg<int>("input");
+		}), Equals("job: 'input' must be of integral type"));
+	}
+}
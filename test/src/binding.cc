@@ -0,0 +1,104 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/**
+ * Settings bound to the arguments of a parser.
+ */
+struct Config {
+	std::string input;
+	unsigned threads{1};
+	bool verbose{false};
+	double ratio{0.5};
+	std::vector<int> ids;
+	String_View label;
+};
+
+TEST_CASE("Binding to members") {
+	Argument_Parser parser;
+	parser.add_positional("input").bind(&Config::input);
+	parser.add_optional("-t", "--threads").bind(&Config::threads);
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG).bind(&Config::verbose);
+	parser.add_optional("--ratio").bind(&Config::ratio);
+	parser.add_optional("-i", "--id", Opt_Type::APPEND).bind(&Config::ids);
+	parser.add_optional("--label").bind(&Config::label);
+
+	SECTION("Given values") {
+		Config config;
+		invoke_parse_args(parser, {"prog", "-t", "8", "in.txt", "-v", "--id", "3", "--ratio", "0.25", "-i", "4", "--label", "run"}, config);
+		REQUIRE(config.input == "in.txt");
+		REQUIRE(config.threads == 8);
+		REQUIRE(config.verbose);
+		REQUIRE(config.ratio == 0.25);
+		REQUIRE(config.ids == std::vector<int>{3, 4});
+		REQUIRE(config.label == "run");
+
+		/* Parsing again keeps the members of omitted arguments */
+		invoke_parse_args(parser, {"prog", "other.txt", "-i", "5"}, config);
+		REQUIRE(config.input == "other.txt");
+		REQUIRE(config.threads == 8);
+		REQUIRE(config.ids == std::vector<int>{5});
+	}
+
+	SECTION("Omitted values keep their defaults") {
+		Config config;
+		invoke_parse_args(parser, {"prog", "in.txt"}, config);
+		REQUIRE(config.input == "in.txt");
+		REQUIRE(config.threads == 1);
+		REQUIRE(!config.verbose);
+		REQUIRE(config.ratio == 0.5);
+		REQUIRE(config.ids.empty());
+	}
+
+	SECTION("Conversion errors") {
+		Config config;
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-t", "many"}, config),
+				Equals("prog: 'threads' must be of integral type"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-t", "-3"}, config),
+				Equals("prog: 'threads' must be in range [0,4294967295]"));
+	}
+
+	SECTION("Missing or mismatched target") {
+		struct Other { };
+		Other other;
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt"}),
+				Equals("Argument_Parser: 'input' is bound to a member, pass the object to write it to parse_args()"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt"}, other),
+				Equals("Argument_Parser: 'input' is bound to a member of a different type than the object passed to parse_args()"));
+	}
+}
+
+TEST_CASE("Binding to variables") {
+	std::string input;
+	int level{3};
+	std::vector<std::string> excludes{"default"};
+	Argument_Parser parser;
+	parser.add_positional("input").bind(input);
+	parser.add_optional("-l", "--level").bind(level);
+	parser.add_optional("--exclude", Opt_Type::APPEND).bind(excludes);
+	parser.add_subcommand("run", [](Argument_Parser &run) {
+		run.add_optional("-n", "--count").bind(&Config::threads);
+	});
+
+	invoke_parse_args(parser, {"prog", "in.txt", "--exclude", "a*", "--exclude", "b*", "run"});
+	REQUIRE(input == "in.txt");
+	REQUIRE(level == 3);
+	REQUIRE(excludes == std::vector<std::string>{"a*", "b*"});
+
+	/* Subcommand parsers write into the same object */
+	Config config;
+	invoke_parse_args(parser, {"prog", "in.txt", "-l", "7", "run", "-n", "2"}, config);
+	REQUIRE(level == 7);
+	REQUIRE(config.threads == 2);
+}
@@ -0,0 +1,97 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/util/convert.h"
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+using namespace cpparse;
+
+template<class T>
+static Convert_Status convert(String_View value, T &out) {
+	return convert_value<T>(value, out);
+}
+
+TEST_CASE("convert_value() integral") {
+	int i{0};
+	REQUIRE(convert("42", i) == Convert_Status::OK);
+	REQUIRE(i == 42);
+	REQUIRE(convert("  -17", i) == Convert_Status::OK);
+	REQUIRE(i == -17);
+	REQUIRE(convert("+8", i) == Convert_Status::OK);
+	REQUIRE(i == 8);
+	REQUIRE(convert("-9.5", i) == Convert_Status::OK);
+	REQUIRE(i == -9);
+	REQUIRE(convert("-0", i) == Convert_Status::OK);
+	REQUIRE(i == 0);
+	REQUIRE(convert("", i) == Convert_Status::INVALID);
+	REQUIRE(convert("-", i) == Convert_Status::INVALID);
+	REQUIRE(convert("abc", i) == Convert_Status::INVALID);
+	REQUIRE(convert("+-1", i) == Convert_Status::INVALID);
+	REQUIRE(convert("2147483648", i) == Convert_Status::OUT_OF_RANGE);
+	REQUIRE(i == 0);
+	REQUIRE(convert("-2147483648", i) == Convert_Status::OK);
+	REQUIRE(i == std::numeric_limits<int>::min());
+
+	std::int64_t i64{0};
+	REQUIRE(convert("-9223372036854775808", i64) == Convert_Status::OK);
+	REQUIRE(i64 == std::numeric_limits<std::int64_t>::min());
+	REQUIRE(convert("9223372036854775808", i64) == Convert_Status::OUT_OF_RANGE);
+	REQUIRE(convert("99999999999999999999999", i64) == Convert_Status::OUT_OF_RANGE);
+
+	unsigned int u{0};
+	REQUIRE(convert("4294967295", u) == Convert_Status::OK);
+	REQUIRE(u == 4294967295u);
+	REQUIRE(convert("4294967296", u) == Convert_Status::OUT_OF_RANGE);
+	REQUIRE(convert("-1", u) == Convert_Status::OUT_OF_RANGE);
+	REQUIRE(convert(" -abc", u) == Convert_Status::OUT_OF_RANGE);
+	REQUIRE(convert("abc", u) == Convert_Status::INVALID);
+
+	std::uint8_t u8{0};
+	REQUIRE(convert("255", u8) == Convert_Status::OK);
+	REQUIRE(u8 == 255);
+	REQUIRE(convert("256", u8) == Convert_Status::OUT_OF_RANGE);
+}
+
+TEST_CASE("convert_value() floating point") {
+	double d{0};
+	REQUIRE(convert("-9.5", d) == Convert_Status::OK);
+	REQUIRE(d == -9.5);
+	REQUIRE(convert(" +1e3xyz", d) == Convert_Status::OK);
+	REQUIRE(d == 1000.0);
+	REQUIRE(convert("0x1p3", d) == Convert_Status::OK);
+	REQUIRE(d == 8.0);
+	REQUIRE(convert("abc", d) == Convert_Status::INVALID);
+	REQUIRE(convert("", d) == Convert_Status::INVALID);
+	REQUIRE(convert("1e999", d) == Convert_Status::OUT_OF_RANGE);
+
+	float f{0};
+	REQUIRE(convert("0.25", f) == Convert_Status::OK);
+	REQUIRE(f == 0.25f);
+	REQUIRE(convert("1e300", f) == Convert_Status::OUT_OF_RANGE);
+
+	const std::string long_value = "1." + std::string(100, '0');
+	REQUIRE(convert(long_value, d) == Convert_Status::OK);
+	REQUIRE(d == 1.0);
+}
+
+TEST_CASE("convert_value() other types") {
+	bool b{false};
+	REQUIRE(convert("yes", b) == Convert_Status::OK);
+	REQUIRE(b);
+	REQUIRE(convert("off", b) == Convert_Status::OK);
+	REQUIRE(!b);
+	REQUIRE(convert("1", b) == Convert_Status::INVALID);
+
+	char c{0};
+	REQUIRE(convert("x", c) == Convert_Status::OK);
+	REQUIRE(c == 'x');
+	REQUIRE(convert("xy", c) == Convert_Status::INVALID);
+
+	std::string s;
+	REQUIRE(convert("text", s) == Convert_Status::OK);
+	REQUIRE(s == "text");
+}
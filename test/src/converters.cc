@@ -0,0 +1,148 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <iterator>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+enum class Level { LOW, HIGH };
+
+/**
+ * Duration given as a number of seconds with an 's' or 'm' suffix.
+ */
+struct Duration {
+	unsigned seconds{0};
+};
+
+static Convert_Status parse_duration(String_View value, Duration &out) {
+	if (value.size() < 2)
+		return Convert_Status::INVALID;
+	unsigned amount;
+	const auto status = convert_value<unsigned>(String_View{value.data(), value.size() - 1}, amount);
+	if (status != Convert_Status::OK)
+		return status;
+	switch (value[value.size() - 1]) {
+	case 's':
+		out.seconds = amount;
+		return Convert_Status::OK;
+	case 'm':
+		out.seconds = amount * 60;
+		return Convert_Status::OK;
+	default:
+		return Convert_Status::INVALID;
+	}
+}
+
+static Convert_Status parse_level(String_View value, Level &out) {
+	if (value == "low")
+		out = Level::LOW;
+	else if (value == "high")
+		out = Level::HIGH;
+	else
+		return Convert_Status::INVALID;
+	return Convert_Status::OK;
+}
+
+/**
+ * Size given in bytes with an optional 'K' or 'M' suffix.
+ */
+static Convert_Status parse_size(String_View value, std::size_t &out) {
+	std::size_t scale{1};
+	const char suffix{value.empty() ? '\0' : value[value.size() - 1]};
+	if (suffix == 'K' || suffix == 'M') {
+		scale = suffix == 'K' ? 1024 : 1024 * 1024;
+		value = String_View{value.data(), value.size() - 1};
+	}
+	const auto status = convert_value<std::size_t>(value, out);
+	out *= scale;
+	return status;
+}
+
+TEST_CASE("Custom converters") {
+	Argument_Parser parser;
+	unsigned duration_calls{0};
+	parser.add_positional("level").converter<Level>(parse_level);
+	parser.add_optional("-t", "--timeout", Opt_Type::APPEND).converter<Duration>([&duration_calls](String_View value, Duration &out) {
+		++duration_calls;
+		return parse_duration(value, out);
+	});
+	parser.add_optional("--buffer").converter<std::size_t>(parse_size);
+	parser.add_optional("--count");
+
+	SECTION("Values are converted once when parsed") {
+		invoke_parse_args(parser, {"prog", "high", "-t", "30s", "--timeout", "2m", "--buffer", "64M"});
+		REQUIRE(duration_calls == 2);
+		REQUIRE(parser.arg<Level>("level") == Level::HIGH);
+		REQUIRE(parser.arg<Duration>("timeout").seconds == 30);
+		REQUIRE(parser.arg_at<Duration>("timeout", 1).seconds == 120);
+		REQUIRE(parser.args<Duration>("timeout").size() == 2);
+		REQUIRE(parser.arg<std::size_t>("buffer") == 64 * 1024 * 1024);
+		REQUIRE(duration_calls == 2);
+
+		/* Other types still use the built-in conversions */
+		REQUIRE(parser.arg<std::string>("timeout") == "30s");
+		REQUIRE(parser.arg<std::string>("buffer") == "64M");
+
+		invoke_parse_args(parser, {"prog", "low", "-t", "5s"});
+		REQUIRE(duration_calls == 3);
+		REQUIRE(parser.arg<Level>("level") == Level::LOW);
+		REQUIRE(parser.args<Duration>("timeout").size() == 1);
+		REQUIRE(parser.arg<std::size_t>("buffer", 4096) == 4096);
+	}
+
+	SECTION("Conversion errors") {
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "medium"}), Equals("prog: 'level' has an invalid value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "low", "-t", "5h"}), Equals("prog: 'timeout' has an invalid value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "low", "--buffer", "lots"}), Equals("prog: 'buffer' must be of integral type"));
+		REQUIRE(!parser.has_arg("timeout"));
+	}
+
+	SECTION("Types without a converter") {
+		invoke_parse_args(parser, {"prog", "low", "--count", "3"});
+		REQUIRE_THROWS_WITH(parser.arg<Duration>("count"), Contains("no converter registered for the requested type of 'count'"));
+		REQUIRE(parser.arg<int>("count") == 3);
+	}
+
+	SECTION("Bulk conversion") {
+		invoke_parse_args(parser, {"prog", "low", "-t", "1s", "-t", "2s", "-t", "3s"});
+		std::vector<Duration> durations;
+		const auto result = parser.args_into<Duration>("timeout", std::back_inserter(durations));
+		REQUIRE(result);
+		REQUIRE(result.count == 3);
+		REQUIRE(durations[2].seconds == 3);
+	}
+
+	SECTION("Parse results") {
+		std::vector<const char *> args{"prog", "high", "-t", "1m", "--buffer", "2K"};
+		const auto result = parser.parse(args.size(), args.data());
+		REQUIRE(result.arg<Level>("level") == Level::HIGH);
+		REQUIRE(result.arg<Duration>("timeout").seconds == 60);
+		REQUIRE(result.arg<std::size_t>("buffer") == 2048);
+	}
+}
+
+TEST_CASE("Custom converters with bindings and callbacks") {
+	Argument_Parser parser;
+	Level level{Level::LOW};
+	std::vector<Duration> timeouts;
+	unsigned total{0};
+	parser.add_optional("--level").converter<Level>(parse_level).bind(level);
+	parser.add_optional("-t", "--timeout", Opt_Type::APPEND).converter<Duration>(parse_duration).bind(timeouts);
+	parser.add_optional("--delay", Opt_Type::APPEND).converter<Duration>(parse_duration)
+			.on_value<Duration>([&total](Duration delay) { total += delay.seconds; });
+
+	invoke_parse_args(parser, {"prog", "--level", "high", "-t", "10s", "-t", "1m", "--delay", "3s", "--delay", "4s"});
+	REQUIRE(level == Level::HIGH);
+	REQUIRE(timeouts.size() == 2);
+	REQUIRE(timeouts[1].seconds == 60);
+	REQUIRE(total == 7);
+}
@@ -0,0 +1,100 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <sstream>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/**
+ * Observer that keeps the last reported metrics.
+ */
+struct Recording_Observer : Summary_Observer {
+	Parse_Metrics last{};
+	std::vector<std::string> converted;
+
+	void parse_finished(const Parse_Metrics &metrics) noexcept override {
+		Summary_Observer::parse_finished(metrics);
+		last = metrics;
+	}
+
+	void value_converted(const Conversion_Metrics &metrics) noexcept override {
+		Summary_Observer::value_converted(metrics);
+		converted.push_back(*metrics.name);
+	}
+};
+
+TEST_CASE("Argument_Parser instrumentation") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_subcommand("run", [](Argument_Parser &run) {
+		run.add_optional("-n", "--count");
+	});
+
+	Recording_Observer observer;
+	parser.set_observer(&observer);
+	invoke_parse_args(parser, {"prog", "-i", "1", "in.txt", "-v", "--id", "2", "run", "-n", "3"});
+	REQUIRE(parser.args<int>("id") == std::vector<int>{1, 2});
+	REQUIRE(parser.subcommand_parser().arg<int>("count") == 3);
+	REQUIRE_THROWS(invoke_parse_args(parser, {"prog", "in.txt", "--bogus"}));
+
+#ifdef CPARSEPARSE_INSTRUMENTATION
+	REQUIRE(observer.parse_count() == 2);
+	REQUIRE(observer.last.failed);
+	const auto &totals = observer.totals();
+	REQUIRE(totals.token_count == 8);  // The subcommand name is its parser's script name
+	REQUIRE(totals.value_count == 5);
+	REQUIRE(totals.allocation_count > 0);
+	REQUIRE(totals.total >= totals.match + totals.assign);
+	REQUIRE(observer.converted == std::vector<std::string>{"id", "id", "count"});
+
+	std::ostringstream out;
+	observer.print(out);
+	REQUIRE_THAT(out.str(), Contains("parses:      2 (1 failed)") && Contains("conversions: 3 in"));
+
+	/* Reparsing with storage already reserved does not allocate */
+	invoke_parse_args(parser, {"prog", "-i", "1", "in.txt", "-v", "--id", "2", "run", "-n", "3"});
+	REQUIRE(!observer.last.failed);
+	REQUIRE(observer.last.allocation_count == 0);
+
+	parser.set_observer(nullptr);
+	invoke_parse_args(parser, {"prog", "in.txt", "run"});
+	REQUIRE(observer.parse_count() == 3);
+#else
+	/* Compiled out */
+	REQUIRE(observer.parse_count() == 0);
+	REQUIRE(observer.converted.empty());
+#endif /* CPARSEPARSE_INSTRUMENTATION */
+}
+
+TEST_CASE("Summary_Observer") {
+	Summary_Observer observer;
+	Parse_Metrics metrics{};
+	metrics.match = std::chrono::microseconds{3};
+	metrics.total = std::chrono::microseconds{4};
+	metrics.token_count = 10;
+	observer.parse_finished(metrics);
+	observer.parse_finished(metrics);
+	const std::string name{"id"};
+	observer.value_converted(Conversion_Metrics{&name, std::chrono::nanoseconds{50}});
+
+	REQUIRE(observer.parse_count() == 2);
+	REQUIRE(observer.totals().token_count == 20);
+	REQUIRE(observer.conversion_count() == 1);
+
+	std::ostringstream out;
+	observer.print(out);
+	REQUIRE_THAT(out.str(), Contains("tokens:      20 (10.0 per parse)"));
+	REQUIRE_THAT(out.str(), Contains("match:       6.0 us (3000.0 ns per parse)"));
+	REQUIRE_THAT(out.str(), Contains("conversions: 1 in 0.1 us (50.0 ns per value)"));
+}
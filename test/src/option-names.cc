@@ -0,0 +1,99 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/util/option-names.h"
+#include <catch2/catch.hpp>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace cpparse;
+
+static const std::vector<std::string> sample_names{
+	"", "-", "--", "---", "a", "ab", "0", "0a", "_", "a-b", "a_b", "a.b",
+	"-a", "-_", "-0", "-ab", "-a0", "-a-", "--a", "--ab", "--a0", "--0a",
+	"--a-b", "--a_b", "--a.b", "---a", "---ab", "--ab=", "-a b", "--help",
+	"--show-time", "--_x", "-Z", "--Zz9-"
+};
+
+TEST_CASE("Option name grammar") {
+	const std::regex positional_re{"\\w[a-zA-Z0-9_-]*"};
+	const std::regex option_re{"-([a-zA-Z_]|-?[a-zA-Z_][a-zA-Z0-9_-]+)"};
+	const std::regex long_re{"--?([a-zA-Z_][a-zA-Z0-9_-]+)"};
+	const std::regex flag_re{"-([a-zA-Z_])"};
+
+	for (const auto &name : sample_names) {
+		INFO("name: '" << name << "'");
+		std::smatch m;
+		REQUIRE(valid_positional_name(name.c_str()) == std::regex_match(name, positional_re));
+		REQUIRE(valid_option_name(name.c_str()) == std::regex_match(name, option_re));
+
+		const auto long_name = long_option_name(name.c_str());
+		REQUIRE((long_name != nullptr) == std::regex_match(name, m, long_re));
+		if (long_name)
+			REQUIRE(std::string{long_name} == m[1].str());
+
+		const auto flag = flag_option_name(name.c_str());
+		REQUIRE((flag != 0) == std::regex_match(name, m, flag_re));
+		if (flag)
+			REQUIRE(flag == m[1].str()[0]);
+	}
+}
+
+TEST_CASE("Option name scanning") {
+	INFO("instruction set: " << name_scan_instruction_set());
+	const std::string name_chars{"abcxyzABCXYZ0129_-"};
+	const std::string stop_chars{"=. \t/\x80\xff@[`{"};
+
+	/* Every alignment and length within a few blocks, for each stop character */
+	std::vector<char> buffer(256);
+	std::size_t mismatches{0};
+	for (std::size_t offset = 0; offset < 64; ++offset) {
+		for (std::size_t length = 0; length < 100; ++length) {
+			for (const auto stop : stop_chars + '\0') {
+				auto p = buffer.data() + offset;
+				for (std::size_t i = 0; i < length; ++i)
+					p[i] = name_chars[(i + offset) % name_chars.size()];
+				p[length] = stop;
+				p[length + 1] = '\0';
+				if (scan_name_chars(p) != p + length || scan_name_chars_scalar(p) != p + length)
+					++mismatches;
+				if (scan_name_chars(p, p + length + 1) != p + length || scan_name_chars(p, p + length / 2) != p + length / 2)
+					++mismatches;
+			}
+		}
+	}
+	REQUIRE(mismatches == 0);
+
+	/* Bytes before the start of the string are ignored */
+	char prefixed[] = "....abc=def";
+	REQUIRE(scan_name_chars(prefixed + 4) == prefixed + 7);
+	REQUIRE(std::string{long_option_name("--log-level")} == "log-level");
+	REQUIRE(long_option_name("--log-level=3") == nullptr);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+
+TEST_CASE("Option name scanning at the end of a page") {
+	const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	const auto p_map = mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	REQUIRE(p_map != MAP_FAILED);
+	const auto pages = static_cast<char *>(p_map);
+	REQUIRE(mprotect(pages + page_size, page_size, PROT_NONE) == 0);
+
+	/* Names ending at the last byte of a readable page, followed by an inaccessible one */
+	for (std::size_t length = 1; length < 70; ++length) {
+		const auto name = pages + page_size - length - 1;
+		for (std::size_t i = 0; i < length; ++i)
+			name[i] = 'a';
+		name[length] = '\0';
+		REQUIRE(scan_name_chars(name) == name + length);
+	}
+	munmap(p_map, 2 * page_size);
+}
+#endif /* defined(__unix__) || defined(__APPLE__) */
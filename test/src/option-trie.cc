@@ -0,0 +1,108 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/* Copies of the static constants, which the assertion macros bind to references */
+static const std::size_t NO_MATCH{Option_Trie::NO_MATCH};
+static const std::size_t AMBIGUOUS{Option_Trie::AMBIGUOUS};
+
+TEST_CASE("Option_Trie") {
+	Option_Trie trie;
+	REQUIRE(trie.insert("verbose", 0));
+	REQUIRE(trie.insert("version", 1));
+	REQUIRE(trie.insert("log", 2));
+	REQUIRE(trie.insert("log-level", 3));
+	REQUIRE(!trie.insert("version", 4));
+	REQUIRE(trie.size() == 4);
+
+	SECTION("Exact lookup") {
+		REQUIRE(trie.find("verbose") == 0);
+		REQUIRE(trie.find("version") == 1);
+		REQUIRE(trie.find("log") == 2);
+		REQUIRE(trie.find("log-level") == 3);
+		REQUIRE(trie.find("verb") == NO_MATCH);
+		REQUIRE(trie.find("verbosely") == NO_MATCH);
+		REQUIRE(trie.find("") == NO_MATCH);
+		REQUIRE(trie.find(String_View{"log-level-extra", 9}) == 3);
+	}
+
+	SECTION("Prefix lookup") {
+		REQUIRE(trie.find_prefix("verb") == 0);
+		REQUIRE(trie.find_prefix("vers") == 1);
+		REQUIRE(trie.find_prefix("ver") == AMBIGUOUS);
+		REQUIRE(trie.find_prefix("v") == AMBIGUOUS);
+		REQUIRE(trie.find_prefix("log") == 2);
+		REQUIRE(trie.find_prefix("log-") == 3);
+		REQUIRE(trie.find_prefix("lo") == AMBIGUOUS);
+		REQUIRE(trie.find_prefix("verbosely") == NO_MATCH);
+		REQUIRE(trie.find_prefix("x") == NO_MATCH);
+		REQUIRE(trie.find_prefix("") == NO_MATCH);
+	}
+
+	SECTION("Many names") {
+		Option_Trie large;
+		for (std::size_t i = 0; i < 1000; ++i)
+			REQUIRE(large.insert("option-" + std::to_string(i), i));
+		std::size_t mismatches{0};
+		for (std::size_t i = 0; i < 1000; ++i) {
+			if (large.find("option-" + std::to_string(i)) != i)
+				++mismatches;
+		}
+		REQUIRE(mismatches == 0);
+		REQUIRE(large.find_prefix("option-") == AMBIGUOUS);
+		REQUIRE(large.find_prefix("option-999") == 999);
+	}
+}
+
+TEST_CASE("Option abbreviations") {
+	Argument_Parser parser{Argument_Parser::Options{}.abbreviations(true)};
+	parser.add_optional("--verbose", Opt_Type::FLAG);
+	parser.add_optional("--version", Opt_Type::FLAG);
+	parser.add_optional("--log");
+	parser.add_optional("--log-level");
+
+	SECTION("Unambiguous prefixes") {
+		invoke_parse_args(parser, {"prog", "--verb", "--log-l", "3", "--log", "file"});
+		REQUIRE(parser.arg<bool>("verbose"));
+		REQUIRE(!parser.arg<bool>("version"));
+		REQUIRE(parser.arg<int>("log-level") == 3);
+		REQUIRE(parser.arg<std::string>("log") == "file");  // Exact match, though also a prefix of '--log-level'
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "--lo", "file"}),
+				Equals("prog: ambiguous option 'lo' could match 'log', 'log-level', pass --help to display possible options"));
+	}
+
+	SECTION("Ambiguous prefixes") {
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "--ver"}),
+				Equals("prog: ambiguous option 'ver' could match 'verbose', 'version', pass --help to display possible options"));
+		const char *args[] = {"prog", "--ve"};
+		const auto status = parser.validate(2, args);
+		REQUIRE(status.error == Parse_Error::AMBIGUOUS_OPTION);
+		REQUIRE(status.index == 1);
+	}
+
+	SECTION("Disabled by default") {
+		Argument_Parser exact;
+		exact.add_optional("--verbose", Opt_Type::FLAG);
+		REQUIRE_THROWS_WITH(invoke_parse_args(exact, {"prog", "--verb"}),
+				Equals("prog: invalid option 'verb', pass --help to display possible options"));
+	}
+
+	SECTION("Subcommands") {
+		parser.add_subcommand("run", [](Argument_Parser &run) {
+			run.add_optional("--count");
+		});
+		invoke_parse_args(parser, {"prog", "run", "--cou", "2"});
+		REQUIRE(parser.subcommand_parser().arg<int>("count") == 2);
+	}
+}
@@ -0,0 +1,148 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+TEST_CASE("Parse_Result values") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-o", "--output");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_optional("--level", Opt_Type::APPEND);
+
+	std::vector<std::string> tokens{"prog", "-i", "1", "--level", "a", "in.txt", "-i", "2", "extra", "--level", "b", "-i", "3", "-v"};
+	std::vector<const char *> args;
+	for (const auto &token : tokens)
+		args.push_back(token.c_str());
+	const auto result = parser.parse(args.size(), args.data());
+	for (auto &token : tokens)
+		token.assign(token.size(), '#');
+
+	REQUIRE(result.script_name() == "prog");
+	REQUIRE(result.arg<std::string>("input") == "in.txt");
+	REQUIRE(result.arg<bool>("verbose"));
+	REQUIRE(!result.has_arg("output"));
+	REQUIRE(result.arg<std::string>("output", "out.txt") == "out.txt");
+	REQUIRE(result.args<int>("id") == std::vector<int>{1, 2, 3});
+	REQUIRE(result.arg_at<int>("id", 2) == 3);
+	REQUIRE(result.args<std::string>("level") == std::vector<std::string>{"a", "b"});
+	REQUIRE(result.extra_args().size() == 1);
+	REQUIRE(result.extra_args()[0] == "extra");
+	REQUIRE(!result.has_subcommand());
+
+	std::vector<int> ids;
+	REQUIRE(result.args_into<int>("id", std::back_inserter(ids)));
+	REQUIRE(ids.size() == 3);
+	REQUIRE_THROWS_WITH(result.arg_at<int>("id", 3), Contains("index 3 is out of range for 'id'"));
+	REQUIRE_THROWS_WITH(result.arg<int>("output"), Contains("no value given for 'output'"));
+	REQUIRE_THROWS_WITH(result.arg<int>("input"), Equals("prog: 'input' must be of integral type"));
+	REQUIRE_THROWS_WITH(result.arg_count("input"), Contains("no optional argument by the name 'input'"));
+	REQUIRE_THROWS_WITH(result.arg<int>("missing"), Contains("no argument by the name 'missing'"));
+
+	/* The parser itself is left untouched */
+	REQUIRE(!parser.has_arg("verbose"));
+	REQUIRE(parser.arg_count("id") == 0);
+}
+
+TEST_CASE("Parse_Result errors") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-o", "--output");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"first", "-o"}), Equals("first: 'output' requires a value"));
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"second", "--bogus"}), StartsWith("second: invalid option 'bogus'"));
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"third", "-z"}), StartsWith("third: invalid flag '-z'"));
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"fourth", "-v", "-v", "in"}), Equals("fourth: 'verbose' should only be specified once"));
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"fifth"}), Equals("fifth: requires positional argument 'input'"));
+}
+
+TEST_CASE("Parse_Result subcommands") {
+	bool defined{false};
+	Argument_Parser parser;
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_subcommand("build", [&defined](Argument_Parser &) { defined = true; });
+
+	/* The subcommand arguments refer into argv, which must outlive the result */
+	std::vector<const char *> args{"prog", "-v", "build", "--jobs", "4"};
+	const auto result = parser.parse(args.size(), args.data());
+	REQUIRE(result.arg<bool>("verbose"));
+	REQUIRE(result.has_subcommand());
+	REQUIRE(result.subcommand() == "build");
+	REQUIRE(result.subcommand_argc() == 3);
+	REQUIRE(String_View{result.subcommand_argv()[0]} == "build");
+	REQUIRE(String_View{result.subcommand_argv()[2]} == "4");
+	REQUIRE(!defined);
+
+	REQUIRE_THROWS_WITH(invoke_parse(parser, {"prog", "-v"}), StartsWith("prog: requires a subcommand"));
+	REQUIRE_THROWS_WITH(invoke_parse(Argument_Parser{}, {"prog"}).subcommand(), Contains("no subcommand was selected"));
+}
+
+TEST_CASE("Parse_Result help flag") {
+	bool help_called{false};
+	Argument_Parser parser;
+	parser.set_description("Sorts things");
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.set_help_handler([&help_called](const Argument_Parser &) { help_called = true; });
+
+	/* Matching stops at the help flag without requiring the positional argument */
+	std::vector<const char *> args{"myprog", "-v", "--help", "--bogus"};
+	const auto result = parser.parse(args.size(), args.data());
+	REQUIRE(!help_called);
+	REQUIRE(result.has_arg("help"));
+	REQUIRE(result.has_arg("verbose"));
+	REQUIRE_THAT(parser.help_text(result.script_name()), StartsWith("Usage: myprog [options] <input>\n\n  Sorts things\n"));
+	REQUIRE_THAT(parser.help_text("other"), StartsWith("Usage: other "));
+}
+
+TEST_CASE("Parse_Result concurrent parsing") {
+	Argument_Parser parser;
+	parser.add_positional("thread");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_optional("--name");
+
+	constexpr int N_THREADS{8};
+	constexpr int N_ITERATIONS{200};
+	std::atomic<int> failures{0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < N_THREADS; ++t) {
+		threads.emplace_back([&parser, &failures, t] {
+			const auto thread = std::to_string(t);
+			const auto script_name = "prog-" + thread;
+			for (int i = 0; i < N_ITERATIONS; ++i) {
+				const auto id = std::to_string(i);
+				const char *args[] = {script_name.c_str(), thread.c_str(), "-i", id.c_str(), "--id", thread.c_str(), "--name", script_name.c_str()};
+				const auto result = parser.parse(8, args);
+				if (result.arg<int>("thread") != t || result.args<int>("id") != std::vector<int>{i, t}
+						|| result.arg<std::string>("name") != script_name)
+					++failures;
+
+				const char *bad_args[] = {script_name.c_str(), thread.c_str(), "--name"};
+				try {
+					parser.parse(3, bad_args);
+					++failures;
+				} catch (const std::runtime_error &ex) {
+					if (std::string{ex.what()} != script_name + ": 'name' requires a value")
+						++failures;
+				}
+			}
+		});
+	}
+	for (auto &thread : threads)
+		thread.join();
+	REQUIRE(failures == 0);
+}
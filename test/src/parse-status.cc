@@ -0,0 +1,132 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/**
+ * Verify that the status matches the message thrown by parse().
+ */
+static void require_same_message(const Argument_Parser &parser, std::vector<const char *> args, const Parse_Status &status) {
+	REQUIRE_THROWS_WITH(parser.parse(args.size(), args.data()), Equals(parser.error_message(status, args[0])));
+}
+
+TEST_CASE("Argument_Parser validate()") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-o", "--output");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+
+	SECTION("Valid") {
+		const auto status = invoke_validate(parser, {"prog", "-i", "1", "in.txt", "-v", "--id", "2", "extra"});
+		REQUIRE(status);
+		REQUIRE(status.error == Parse_Error::NONE);
+		REQUIRE(status.index == 8);
+		REQUIRE(invoke_validate(parser, {"prog", "in.txt", "--help"}));
+		REQUIRE(parser.error_message(status, "prog").empty());
+	}
+	SECTION("Errors") {
+		struct Case {
+			std::vector<const char *> args;
+			Parse_Error error;
+			int index;
+			const char *message;
+		};
+		const std::vector<Case> cases{
+			{{"prog", "in.txt", "-z"}, Parse_Error::INVALID_FLAG, 2,
+					"prog: invalid flag '-z', pass --help to display possible options"},
+			{{"prog", "--bogus", "in.txt"}, Parse_Error::INVALID_OPTION, 1,
+					"prog: invalid option 'bogus', pass --help to display possible options"},
+			{{"prog", "in.txt", "-o"}, Parse_Error::MISSING_VALUE, 2, "prog: 'output' requires a value"},
+			{{"prog", "-o", "-v", "in.txt"}, Parse_Error::MISSING_VALUE, 1, "prog: 'output' requires a value"},
+			{{"prog", "-v", "in.txt", "--verbose"}, Parse_Error::REPEATED_ARGUMENT, 3, "prog: 'verbose' should only be specified once"},
+			{{"prog", "-o", "a", "-o", "b", "in.txt"}, Parse_Error::REPEATED_ARGUMENT, 3, "prog: 'output' should only be specified once"},
+			{{"prog", "-i", "1"}, Parse_Error::MISSING_POSITIONAL, 3, "prog: requires positional argument 'input'"}
+		};
+		for (const auto &c : cases) {
+			const auto status = invoke_validate(parser, c.args);
+			REQUIRE(!status);
+			REQUIRE(status.error == c.error);
+			REQUIRE(status.index == c.index);
+			REQUIRE(parser.error_message(status, "prog") == c.message);
+			require_same_message(parser, c.args, status);
+		}
+		const auto status = invoke_validate(parser, {"prog", "in.txt", "-z"});
+		REQUIRE(status.token == std::string{"-z"});
+		REQUIRE(parser.error_message(status, "other") == "other: invalid flag '-z', pass --help to display possible options");
+	}
+	SECTION("More optional arguments than fit inline") {
+		Argument_Parser large;
+		for (int i = 0; i < 300; ++i)
+			large.add_optional("--opt" + std::to_string(i));
+		REQUIRE(invoke_validate(large, {"prog", "--opt299", "a", "--opt0", "b"}));
+		const auto status = invoke_validate(large, {"prog", "--opt299", "a", "--opt299", "b"});
+		REQUIRE(status.error == Parse_Error::REPEATED_ARGUMENT);
+		REQUIRE(large.error_message(status, "prog") == "prog: 'opt299' should only be specified once");
+	}
+}
+
+TEST_CASE("Argument_Parser validate() with subcommands") {
+	Argument_Parser git;
+	git.add_optional("-C", "--directory");
+	git.add_subcommand("commit", [](Argument_Parser &) { });
+
+	auto status = invoke_validate(git, {"git", "-C", "repo", "commit", "--bogus"});
+	REQUIRE(status);
+	REQUIRE(status.index == 3);
+
+	std::vector<const char *> args{"git", "-C", "repo", "push"};
+	status = invoke_validate(git, args);
+	REQUIRE(status.error == Parse_Error::INVALID_SUBCOMMAND);
+	REQUIRE(status.index == 3);
+	REQUIRE(git.error_message(status, "git") == "git: invalid subcommand 'push', pass --help to display possible subcommands");
+	require_same_message(git, args, status);
+
+	args = {"git", "-C", "repo"};
+	status = invoke_validate(git, args);
+	REQUIRE(status.error == Parse_Error::MISSING_SUBCOMMAND);
+	REQUIRE(status.index == 3);
+	require_same_message(git, args, status);
+}
+
+TEST_CASE("Argument_Parser try_parse()") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+
+	std::vector<const char *> args{"prog", "-i", "1", "in.txt", "-i", "2", "extra"};
+	Parse_Status status;
+	auto result = parser.try_parse(args.size(), args.data(), status);
+	REQUIRE(status);
+	REQUIRE(result.arg<std::string>("input") == "in.txt");
+	REQUIRE(result.args<int>("id") == std::vector<int>{1, 2});
+	REQUIRE(result.extra_args().size() == 1);
+
+	args = {"prog", "-i", "1", "extra", "-i"};
+	result = parser.try_parse(args.size(), args.data(), status);
+	REQUIRE(status.error == Parse_Error::MISSING_VALUE);
+	REQUIRE(status.index == 4);
+	REQUIRE(status.argument == 1);  // Following the automatic help flag
+	REQUIRE(result.arg_count("id") == 0);
+	REQUIRE(result.extra_args().empty());
+	REQUIRE_THROWS_WITH(result.arg<std::string>("input"), Contains("no value given for 'input'"));
+
+	/* The help handler is not invoked */
+	bool help_called{false};
+	parser.set_help_handler([&help_called](const Argument_Parser &) { help_called = true; });
+	args = {"prog", "in.txt", "-h"};
+	result = parser.try_parse(args.size(), args.data(), status);
+	REQUIRE(status);
+	REQUIRE(!help_called);
+	REQUIRE(result.arg<bool>("help"));
+}
@@ -0,0 +1,80 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <sstream>
+
+#ifdef CPARSEPARSE_HAS_SHARED_MAPPING
+#include <sys/wait.h>
+#include <unistd.h>
+#endif /* CPARSEPARSE_HAS_SHARED_MAPPING */
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+static bool in_region(const Shared_Region &region, String_View value) {
+	return value.data() >= region.data() && value.data() + value.size() < region.data() + region.size();
+}
+
+TEST_CASE("Sealing parsed values") {
+	Argument_Parser parser;
+	parser.add_positional("input");
+	parser.add_optional("-l", "--level");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_optional("--tag");
+	parser.add_subcommand("run", [](Argument_Parser &run) {
+		run.add_positional("target");
+	});
+	invoke_parse_args(parser, {"prog", "in.txt", "-l", "5", "-i", "1", "--id", "22", "run", "all"});
+	REQUIRE(parser.sealed_region() == nullptr);
+
+	parser.seal();
+	const auto region = parser.sealed_region();
+	REQUIRE(region != nullptr);
+	REQUIRE(parser.arg<std::string>("input") == "in.txt");
+	REQUIRE(parser.arg<int>("level") == 5);
+	REQUIRE(parser.args<int>("id") == std::vector<int>{1, 22});
+	REQUIRE(parser.arg<std::string>("tag", "none") == "none");
+	REQUIRE(parser.subcommand() == "run");
+	REQUIRE(parser.subcommand_parser().arg<std::string>("target") == "all");
+	std::ostringstream usage;
+	parser.print_usage(usage);
+	REQUIRE_THAT(usage.str(), StartsWith("Usage: prog"));
+
+	/* Every value, including those of the subcommand, is read from the region */
+	REQUIRE(in_region(*region, parser.arg<String_View>("input")));
+	REQUIRE(in_region(*region, parser.args<String_View>("id")[1]));
+	REQUIRE(in_region(*region, parser.subcommand_parser().arg<String_View>("target")));
+
+	/* Sealing again compacts the sealed values into a new region */
+	parser.seal();
+	REQUIRE(parser.sealed_region() != nullptr);
+	REQUIRE(parser.arg<int>("level") == 5);
+
+#ifdef CPARSEPARSE_HAS_SHARED_MAPPING
+	/* Forked workers read the values from the shared pages */
+	const auto pid = ::fork();
+	REQUIRE(pid >= 0);
+	if (pid == 0) {
+		const bool ok = parser.arg<std::string>("input") == "in.txt" && parser.subcommand_parser().arg<std::string>("target") == "all";
+		::_exit(ok ? 0 : 1);
+	}
+	int status;
+	REQUIRE(::waitpid(pid, &status, 0) == pid);
+	REQUIRE(WIFEXITED(status));
+	REQUIRE(WEXITSTATUS(status) == 0);
+#endif /* CPARSEPARSE_HAS_SHARED_MAPPING */
+
+	/* Parsing again releases the region */
+	invoke_parse_args(parser, {"prog", "other.txt", "run", "some"});
+	REQUIRE(parser.sealed_region() == nullptr);
+	REQUIRE(parser.arg<std::string>("input") == "other.txt");
+	REQUIRE(parser.subcommand_parser().arg<std::string>("target") == "some");
+}
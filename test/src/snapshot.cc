@@ -0,0 +1,97 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <sstream>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+static void define_arguments(Argument_Parser &parser) {
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-l", "--level");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_subcommand("run", [](Argument_Parser &run) {
+		run.add_positional("target");
+		run.add_optional("-n", "--count");
+	});
+	parser.add_subcommand("clean", [](Argument_Parser &) { });
+}
+
+TEST_CASE("Argument_Parser snapshots") {
+	Argument_Parser supervisor;
+	define_arguments(supervisor);
+	invoke_parse_args(supervisor, {"prog", "-v", "in.txt", "--id", "1", "-i", "22", "-l", "5", "run", "all", "-n", "3", "extra"});
+	const auto blob = supervisor.snapshot();
+
+	Argument_Parser worker;
+	define_arguments(worker);
+
+	SECTION("Restoring from memory") {
+		worker.load_snapshot(blob.data(), blob.size());
+		REQUIRE(worker.arg<std::string>("input") == "in.txt");
+		REQUIRE(worker.arg<bool>("verbose"));
+		REQUIRE(worker.arg<int>("level") == 5);
+		REQUIRE(worker.args<int>("id") == std::vector<int>{1, 22});
+		REQUIRE(worker.subcommand() == "run");
+		const auto &run = worker.subcommand_parser();
+		REQUIRE(run.arg<std::string>("target") == "all");
+		REQUIRE(run.arg<int>("count") == 3);
+		std::ostringstream usage;
+		run.print_usage(usage);
+		REQUIRE_THAT(usage.str(), StartsWith("Usage: prog run"));
+
+		/* Values refer directly to the snapshot */
+		const auto input = worker.arg<String_View>("input");
+		REQUIRE(input.data() >= blob.data());
+		REQUIRE(input.data() < blob.data() + blob.size());
+
+		/* The restored parser saves an identical snapshot */
+		REQUIRE(worker.snapshot() == blob);
+	}
+
+	SECTION("Restoring from a file") {
+		const std::string path{"snapshot-test.bin"};
+		supervisor.save_snapshot(path);
+		worker.load_snapshot(path);
+		std::remove(path.c_str());
+		REQUIRE(worker.arg<int>("level") == 5);
+		REQUIRE(worker.subcommand_parser().arg<int>("count") == 3);
+
+		/* Parsing afterwards replaces the restored values */
+		invoke_parse_args(worker, {"prog", "other.txt", "clean"});
+		REQUIRE(worker.arg<std::string>("input") == "other.txt");
+		REQUIRE(!worker.arg<bool>("verbose"));
+		REQUIRE(worker.subcommand() == "clean");
+	}
+
+	SECTION("Invalid snapshots") {
+		REQUIRE_THROWS_WITH(worker.load_snapshot(blob.data(), 10), Equals("invalid snapshot: not a snapshot"));
+		REQUIRE_THROWS_WITH(worker.load_snapshot(blob.data(), blob.size() - 1), Equals("invalid snapshot: truncated snapshot"));
+
+		auto corrupted = blob;
+		corrupted[8] = 99;
+		REQUIRE_THROWS_WITH(worker.load_snapshot(corrupted.data(), corrupted.size()), Equals("invalid snapshot: unsupported snapshot version"));
+
+		corrupted = blob;
+		corrupted[corrupted.size() - 1] = 'x';
+		REQUIRE_THROWS_WITH(worker.load_snapshot(corrupted.data(), corrupted.size()), Equals("invalid snapshot: snapshot string out of bounds"));
+		REQUIRE(!worker.has_subcommand());
+
+		Argument_Parser different;
+		define_arguments(different);
+		different.add_optional("--extra");
+		REQUIRE_THROWS_WITH(different.load_snapshot(blob.data(), blob.size()),
+				Equals("invalid snapshot: argument definitions differ from those of the saving parser"));
+		REQUIRE_THROWS_WITH(worker.load_snapshot("no-such-snapshot.bin"), Equals("cannot open file 'no-such-snapshot.bin'"));
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+static constexpr auto schema = make_static_schema(
+	static_positional("input"),
+	static_optional("-v", "--verbose", Opt_Type::FLAG),
+	static_optional("--threads"),
+	static_optional("-x", "--exclude", Opt_Type::APPEND)
+);
+
+static_assert(schema.size() == 4, "schema size");
+static_assert(schema.index_of("verbose") == 1, "schema lookup");
+static_assert(schema.index_of("exclude") == 3, "schema lookup");
+static_assert(schema.index_of("missing") == schema.size(), "schema lookup");
+static_assert(schema[1].flag == 'v' && schema[2].flag == 0, "schema flags");
+static_assert(schema[3].type == Opt_Type::APPEND, "schema types");
+
+TEST_CASE("Static_Schema definitions") {
+	REQUIRE(String_View(schema[0].name, schema[0].name_size) == "input");
+	REQUIRE(String_View(schema[2].name, schema[2].name_size) == "threads");
+	REQUIRE(schema[2].hash == String_View_Hash{}("threads"));
+
+	REQUIRE_THROWS_WITH(static_positional("-input"), Equals("invalid positional argument name"));
+	REQUIRE_THROWS_WITH(static_optional("--1abc"), Equals("invalid optional argument name"));
+	REQUIRE_THROWS_WITH(static_optional("--a"), Equals("invalid optional argument name"));
+	REQUIRE_THROWS_WITH(static_optional("-ab", "--abc"), Equals("invalid flag name"));
+	REQUIRE_THROWS_WITH(make_static_schema(static_optional("--abc"), static_optional("-abc")), Equals("duplicate argument name"));
+	REQUIRE_THROWS_WITH(make_static_schema(static_optional("-a", "--abc"), static_optional("-a", "--def")), Equals("duplicate flag name"));
+	REQUIRE_THROWS_WITH(make_static_schema(static_positional("abc"), static_optional("--abc")),
+			Equals("argument name conflicts between positional and optional arguments"));
+}
+
+TEST_CASE("Argument_Parser static schema") {
+	SECTION("Parsing") {
+		Argument_Parser parser{schema};
+		parser.add_optional("--late");
+		invoke_parse_args(parser, {"test-program", "-x", "a", "in.txt", "--threads", "4", "--exclude", "b", "--late", "1"});
+		REQUIRE(parser.arg<std::string>("input") == "in.txt");
+		REQUIRE(!parser.arg<bool>("verbose"));
+		REQUIRE(parser.arg<int>("threads") == 4);
+		REQUIRE(parser.args<std::string>("exclude") == std::vector<std::string>{"a", "b"});
+		REQUIRE(parser.arg<int>("late") == 1);
+		REQUIRE_THROWS_WITH(parser.add_optional("-v", "--other"), Contains("duplicate flag name '-v'"));
+		REQUIRE_THROWS_WITH(parser.add_positional("input"), Contains("duplicate positional argument name 'input'"));
+		REQUIRE_THROWS_WITH(parser.add_optional("--threads"), Contains("duplicate optional argument name 'threads'"));
+		REQUIRE_THROWS_WITH(parser.add_positional("exclude"), Contains("conflicts with optional argument reference name 'exclude'"));
+	}
+	SECTION("Conflicts with automatic help") {
+		static constexpr auto help_option = make_static_schema(static_optional("--help"));
+		static constexpr auto help_flag = make_static_schema(static_optional("-h", "--host"));
+		static constexpr auto help_positional = make_static_schema(static_positional("help"));
+		REQUIRE_THROWS_WITH(Argument_Parser{help_option}, Contains("duplicate optional argument name 'help'"));
+		REQUIRE_THROWS_WITH(Argument_Parser{help_flag}, Contains("duplicate flag name '-h'"));
+		REQUIRE_THROWS_WITH(Argument_Parser{help_positional}, Contains("conflicts with optional argument reference name 'help'"));
+		REQUIRE_NOTHROW(Argument_Parser{help_flag, Argument_Parser::Options{}.auto_help(false)});
+	}
+}
@@ -0,0 +1,50 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#ifndef CPARSEPARSE_TEST_HELPERS_H_
+#define CPARSEPARSE_TEST_HELPERS_H_
+
+#include "cparseparse/argument-parser.h"
+#include <vector>
+
+/**
+ * Parse the command-line arguments with parse_args().
+ */
+inline void invoke_parse_args(cpparse::Argument_Parser &parser, std::vector<const char *> args) {
+	int argc = args.size();
+	auto argv = args.data();
+	parser.parse_args(argc, argv);
+}
+
+/**
+ * Parse the command-line arguments with parse_args(), writing the bound members
+ * of @a target.
+ */
+template<class Struct>
+void invoke_parse_args(cpparse::Argument_Parser &parser, std::vector<const char *> args, Struct &target) {
+	int argc = args.size();
+	auto argv = args.data();
+	parser.parse_args(argc, argv, target);
+}
+
+/**
+ * Parse the command-line arguments with parse().
+ *
+ * The subcommand_argv() of the result refers to the temporary argument list, so
+ * tests of the subcommand arguments must keep their own list alive instead.
+ */
+inline cpparse::Parse_Result invoke_parse(const cpparse::Argument_Parser &parser, std::vector<const char *> args) {
+	return parser.parse(args.size(), args.data());
+}
+
+/**
+ * Check the command-line arguments with validate().
+ */
+inline cpparse::Parse_Status invoke_validate(const cpparse::Argument_Parser &parser, std::vector<const char *> args) {
+	return parser.validate(args.size(), args.data());
+}
+
+#endif /* CPARSEPARSE_TEST_HELPERS_H_ */
@@ -0,0 +1,112 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+using Options = Argument_Parser::Options;
+
+static void define_arguments(Argument_Parser &parser) {
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-f", "--force", Opt_Type::FLAG);
+	parser.add_optional("-l", "--level");
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+	parser.add_optional("-fast", Opt_Type::FLAG);
+}
+
+TEST_CASE("Inline option values") {
+	Argument_Parser parser{Options{}.inline_values(true).zero_copy(true)};
+	define_arguments(parser);
+
+	SECTION("Values attached with '='") {
+		std::vector<const char *> args{"prog", "--level=5", "in.txt", "-i=1", "--id=a=b", "-i", "3", "--fast"};
+		invoke_parse_args(parser, args);
+		REQUIRE(parser.arg<int>("level") == 5);
+		REQUIRE(parser.args<std::string>("id") == std::vector<std::string>{"1", "a=b", "3"});
+		REQUIRE(parser.arg<bool>("fast"));
+
+		/* Values refer to the argv strings after the '=' */
+		REQUIRE(parser.arg<String_View>("level").data() == args[1] + 8);
+		REQUIRE(parser.args<String_View>("id")[0].data() == args[3] + 3);
+	}
+	SECTION("Empty values") {
+		invoke_parse_args(parser, {"prog", "in.txt", "--level="});
+		REQUIRE(parser.arg<std::string>("level").empty());
+	}
+	SECTION("Errors") {
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "--verbose=yes"}), Equals("prog: 'verbose' does not take a value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-v="}), Equals("prog: 'verbose' does not take a value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "--bogus=1"}),
+				Equals("prog: invalid option 'bogus', pass --help to display possible options"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-l", "--id=1"}), Equals("prog: 'level' requires a value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "--level=1", "-l=2"}), Equals("prog: 'level' should only be specified once"));
+
+		const auto status = invoke_validate(parser, {"prog", "in.txt", "--force=no"});
+		REQUIRE(status.error == Parse_Error::UNEXPECTED_VALUE);
+		REQUIRE(status.index == 2);
+	}
+	SECTION("Disabled") {
+		Argument_Parser plain;
+		define_arguments(plain);
+		invoke_parse_args(plain, {"prog", "--level=5"});
+		REQUIRE(plain.arg<std::string>("input") == "--level=5");
+		REQUIRE(!plain.has_arg("level"));
+	}
+}
+
+TEST_CASE("Bundled flags") {
+	Argument_Parser parser{Options{}.bundled_flags(true).zero_copy(true)};
+	define_arguments(parser);
+
+	SECTION("Flags only") {
+		invoke_parse_args(parser, {"prog", "-vf", "in.txt"});
+		REQUIRE(parser.arg<bool>("verbose"));
+		REQUIRE(parser.arg<bool>("force"));
+	}
+	SECTION("Flag taking a value") {
+		std::vector<const char *> args{"prog", "-vl7", "in.txt", "-fi", "2", "-i3"};
+		invoke_parse_args(parser, args);
+		REQUIRE(parser.arg<bool>("verbose"));
+		REQUIRE(parser.arg<bool>("force"));
+		REQUIRE(parser.arg<int>("level") == 7);
+		REQUIRE(parser.args<int>("id") == std::vector<int>{2, 3});
+		REQUIRE(parser.arg<String_View>("level").data() == args[1] + 3);
+	}
+	SECTION("Exact single-dash option names take precedence") {
+		invoke_parse_args(parser, {"prog", "-fast", "in.txt"});
+		REQUIRE(parser.arg<bool>("fast"));
+		REQUIRE(!parser.arg<bool>("force"));
+	}
+	SECTION("Errors") {
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-vzf"}),
+				Equals("prog: invalid flag '-z' in '-vzf', pass --help to display possible options"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-z"}),
+				Equals("prog: invalid flag '-z', pass --help to display possible options"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-vv"}), Equals("prog: 'verbose' should only be specified once"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "-vl"}), Equals("prog: 'level' requires a value"));
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "in.txt", "--vf"}),
+				Equals("prog: invalid option 'vf', pass --help to display possible options"));
+	}
+	SECTION("Combined with inline values and subcommands") {
+		Argument_Parser combined{Options{}.bundled_flags(true).inline_values(true)};
+		combined.add_optional("-v", "--verbose", Opt_Type::FLAG);
+		combined.add_optional("-l", "--level");
+		combined.add_subcommand("run", [](Argument_Parser &run) {
+			run.add_optional("-q", "--quiet", Opt_Type::FLAG);
+			run.add_optional("-n", "--count");
+		});
+		invoke_parse_args(combined, {"prog", "-vl=info", "run", "-qn=4"});
+		REQUIRE(combined.arg<std::string>("level") == "info");
+		REQUIRE(combined.subcommand_parser().arg<bool>("quiet"));
+		REQUIRE(combined.subcommand_parser().arg<int>("count") == 4);
+	}
+}
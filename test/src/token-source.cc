@@ -0,0 +1,174 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+static std::vector<std::string> read_all(Token_Source &source) {
+	std::vector<std::string> tokens;
+	while (const auto token = source.next())
+		tokens.emplace_back(token);
+	return tokens;
+}
+
+/**
+ * Temporary file removed when it goes out of scope.
+ */
+struct Temp_File {
+	std::string path;
+
+	Temp_File(const std::string &name, const std::string &contents)
+			: path{"cparseparse-test-" + name} {
+		std::ofstream{path} << contents;
+	}
+
+	~Temp_File() {
+		std::remove(path.c_str());
+	}
+};
+
+TEST_CASE("Token_Source sources") {
+	SECTION("Argv") {
+		const char *args[] = {"prog", "a", "b"};
+		Argv_Source source{3, args};
+		REQUIRE(read_all(source) == std::vector<std::string>{"a", "b"});
+		REQUIRE(source.next() == nullptr);
+	}
+	SECTION("Iterator") {
+		const std::vector<std::string> strings{"a", "", "c"};
+		auto source = make_token_source(strings.begin(), strings.end());
+		REQUIRE(read_all(source) == strings);
+
+		std::istringstream in{"x y z"};
+		auto stream_source = make_token_source(std::istream_iterator<std::string>{in}, std::istream_iterator<std::string>{});
+		REQUIRE(read_all(stream_source) == std::vector<std::string>{"x", "y", "z"});
+	}
+	SECTION("Stream quoting") {
+		std::istringstream in{"  plain\t'single quoted'\n\"double \\\"quoted\\\"\" esc\\ aped '' 'a\\b' mixed'  'word \"unterminated"};
+		Stream_Source source{in};
+		REQUIRE(read_all(source) == std::vector<std::string>{"plain", "single quoted", "double \"quoted\"", "esc aped", "", "a\\b",
+				"mixed  word", "unterminated"});
+	}
+	SECTION("File") {
+		const Temp_File file{"file", "--id 1\n--id 2\n"};
+		File_Source source{file.path};
+		REQUIRE(read_all(source) == std::vector<std::string>{"--id", "1", "--id", "2"});
+
+		const Temp_File empty{"empty", ""};
+		File_Source empty_source{empty.path};
+		REQUIRE(empty_source.next() == nullptr);
+		REQUIRE_THROWS_WITH(File_Source{"cparseparse-test-missing"}, Contains("cannot open file 'cparseparse-test-missing'"));
+	}
+#if defined(__unix__) || defined(__APPLE__)
+	SECTION("Pipe") {
+		/* More than a pipe buffer holds, so that it is read in several chunks */
+		std::string contents{"in.txt -l 3"};
+		for (int i = 0; i < 50000; ++i)
+			contents += " -i " + std::to_string(i);
+		int fds[2];
+		REQUIRE(::pipe(fds) == 0);
+		std::thread writer{[&] {
+			for (std::size_t written = 0; written < contents.size(); ) {
+				const auto n_written = ::write(fds[1], contents.data() + written, contents.size() - written);
+				if (n_written < 0)
+					break;
+				written += static_cast<std::size_t>(n_written);
+			}
+			::close(fds[1]);
+		}};
+		std::vector<std::string> tokens;
+		{
+			File_Source source{"/dev/fd/" + std::to_string(fds[0])};
+			tokens = read_all(source);
+		}
+		writer.join();
+		::close(fds[0]);
+		REQUIRE(tokens.size() == 3 + 2 * 50000);
+		REQUIRE(tokens[0] == "in.txt");
+		REQUIRE(tokens[2] == "3");
+		REQUIRE(tokens.back() == "49999");
+	}
+#endif /* defined(__unix__) || defined(__APPLE__) */
+	SECTION("Response files") {
+		const Temp_File inner{"inner", "c d"};
+		const Temp_File outer{"outer", "b @" + inner.path + " e"};
+		const auto outer_arg = "@" + outer.path;
+		const char *args[] = {"prog", "a", outer_arg.c_str(), "f", "@"};
+		Argv_Source argv_source{5, args};
+		Response_File_Source source{argv_source};
+		REQUIRE(read_all(source) == std::vector<std::string>{"a", "b", "c", "d", "e", "f", "@"});
+
+		const Temp_File loop{"loop", "@cparseparse-test-loop"};
+		std::istringstream in{"@" + loop.path};
+		Stream_Source stream_source{in};
+		Response_File_Source loop_source{stream_source};
+		REQUIRE_THROWS_WITH(read_all(loop_source), Contains("is nested too deeply"));
+	}
+}
+
+TEST_CASE("Argument_Parser parse() from a token source") {
+	Argument_Parser parser{Argument_Parser::Options{}.zero_copy(true)};
+	parser.add_positional("input");
+	parser.add_optional("-v", "--verbose", Opt_Type::FLAG);
+	parser.add_optional("-i", "--id", Opt_Type::APPEND);
+
+	SECTION("Values outlive the source") {
+		std::unique_ptr<Parse_Result> result;
+		{
+			std::istringstream in{"-i 1 'in file.txt' --id 2 -v extra"};
+			Stream_Source source{in};
+			result.reset(new Parse_Result{parser.parse("prog", source)});
+		}
+		REQUIRE(result->arg<std::string>("input") == "in file.txt");
+		REQUIRE(result->args<int>("id") == std::vector<int>{1, 2});
+		REQUIRE(result->arg<bool>("verbose"));
+		REQUIRE(result->extra_args().size() == 1);
+		REQUIRE(result->extra_args()[0] == "extra");
+	}
+	SECTION("Many values") {
+		std::ostringstream out;
+		out << "input";
+		for (int i = 0; i < 100000; ++i)
+			out << " -i " << i;
+		const Temp_File file{"many", out.str()};
+		File_Source source{file.path};
+		const auto result = parser.parse("prog", source);
+		REQUIRE(result.arg_count("id") == 100000);
+		REQUIRE(result.arg_at<int>("id", 99999) == 99999);
+	}
+	SECTION("Errors") {
+		std::istringstream in{"in --id"};
+		Stream_Source source{in};
+		REQUIRE_THROWS_WITH(parser.parse("streamed", source), Equals("streamed: 'id' requires a value"));
+	}
+	SECTION("Subcommands") {
+		Argument_Parser git;
+		git.add_subcommand("commit", [](Argument_Parser &) { });
+		Argument_Parser commit;
+		commit.add_optional("-m", "--message");
+
+		std::istringstream in{"commit -m 'first commit'"};
+		Stream_Source source{in};
+		const auto result = git.parse("git", source);
+		REQUIRE(result.subcommand() == "commit");
+		REQUIRE(result.subcommand_argv() == nullptr);
+		REQUIRE(commit.parse("git commit", source).arg<std::string>("message") == "first commit");
+	}
+}
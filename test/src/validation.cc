@@ -0,0 +1,104 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+static std::string require_txt(String_View value) {
+	const std::string suffix{".txt"};
+	if (value.size() < suffix.size() || value.substr(value.size() - suffix.size()) != suffix)
+		return "expected a .txt file";
+	return "";
+}
+
+TEST_CASE("Value validators") {
+	Argument_Parser parser;
+	parser.add_positional("output").validator(require_txt);
+	parser.add_optional("-i", "--input", Opt_Type::APPEND).validator(require_txt).validator([](String_View value) {
+		return value.size() > 10 ? std::string{"name is too long"} : std::string{};
+	});
+	auto &level = parser.add_optional("--level");
+
+	SECTION("Valid values") {
+		invoke_parse_args(parser, {"prog", "out.txt", "-i", "a.txt", "--input", "b.txt", "--level", "3"});
+		REQUIRE(parser.arg<std::string>("output") == "out.txt");
+		REQUIRE(parser.arg_count("input") == 2);
+	}
+
+	SECTION("Every failure is reported") {
+		try {
+			invoke_parse_args(parser, {"prog", "out.csv", "-i", "a.txt", "-i", "b.csv", "-i", "long-name.csv"});
+			FAIL("parse_args() did not throw");
+		} catch (const Validation_Error &error) {
+			REQUIRE(error.failures().size() == 4);
+			REQUIRE(error.failures()[0].name == "output");
+			REQUIRE(error.failures()[0].value == "out.csv");
+			REQUIRE(error.failures()[3].message == "name is too long");
+			REQUIRE_THAT(error.what(), Equals("prog: invalid value 'out.csv' for 'output': expected a .txt file\n"
+					"prog: invalid value 'b.csv' for 'input': expected a .txt file\n"
+					"prog: invalid value 'long-name.csv' for 'input': expected a .txt file\n"
+					"prog: invalid value 'long-name.csv' for 'input': name is too long"));
+		}
+		REQUIRE(!parser.has_arg("input"));
+	}
+
+	SECTION("Exceptions thrown by validators") {
+		level.validator([](String_View) -> std::string { throw std::runtime_error{"lookup failed"}; });
+		REQUIRE_THROWS_WITH(invoke_parse_args(parser, {"prog", "out.txt", "--level", "3"}), Equals("lookup failed"));
+		invoke_parse_args(parser, {"prog", "out.txt"});
+	}
+
+	SECTION("Validators are not run by parse()") {
+		std::vector<const char *> args{"prog", "out.csv"};
+		const auto result = parser.parse(args.size(), args.data());
+		REQUIRE(result.arg<std::string>("output") == "out.csv");
+	}
+}
+
+TEST_CASE("Validators cannot be combined with value callbacks") {
+	Argument_Parser parser;
+	std::vector<std::string> received;
+	const auto reject_bad = [](String_View value) { return value == "bad" ? std::string{"bad value"} : std::string{}; };
+	const auto receive = [&received](std::string value) { received.push_back(std::move(value)); };
+	auto &input = parser.add_optional("--input", Opt_Type::APPEND).validator(reject_bad);
+	REQUIRE_THROWS_WITH(input.on_value<std::string>(receive), Contains("value callback for 'input' cannot be combined with validators"));
+	auto &output = parser.add_optional("--output", Opt_Type::APPEND).on_value<std::string>(receive);
+	REQUIRE_THROWS_WITH(output.validator(reject_bad), Contains("validator for 'output' cannot be combined with a value callback"));
+
+	REQUIRE_THROWS_AS(invoke_parse_args(parser, {"prog", "--input", "good", "--input", "bad"}), Validation_Error);
+	invoke_parse_args(parser, {"prog", "--output", "good", "--output", "bad"});
+	REQUIRE(received == std::vector<std::string>{"good", "bad"});
+}
+
+TEST_CASE("Validators run concurrently") {
+	constexpr unsigned N{4};
+	Argument_Parser parser{Argument_Parser::Options{}.validation_threads(N)};
+	std::mutex mutex;
+	std::condition_variable started;
+	unsigned n_started{0};
+	parser.add_optional("--host", Opt_Type::APPEND).validator([&](String_View) {
+		/* Each check waits until all of them are in progress at once */
+		std::unique_lock<std::mutex> lock{mutex};
+		++n_started;
+		started.notify_all();
+		if (!started.wait_for(lock, std::chrono::seconds{10}, [&] { return n_started == N; }))
+			return std::string{"checks did not overlap"};
+		return std::string{};
+	});
+
+	invoke_parse_args(parser, {"prog", "--host", "a", "--host", "b", "--host", "c", "--host", "d"});
+	REQUIRE(n_started == N);
+	REQUIRE(parser.arg_count("host") == N);
+}
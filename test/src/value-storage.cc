@@ -0,0 +1,117 @@
+/*
+ * Author: Matthew Rasa
+ * E-mail: matt@raztech.com
+ * GitHub: https://github.com/MatthewRasa
+ */
+
+#include "cparseparse/argument-parser.h"
+#include "test-helpers.h"
+#include <catch2/catch.hpp>
+
+using namespace Catch::Matchers;
+using namespace cpparse;
+
+using Opt_Type = Optional_Info::Type;
+
+/**
+ * Command line giving @a n values of '--id'.
+ */
+static std::vector<std::string> id_tokens(std::size_t n) {
+	std::vector<std::string> tokens{"prog"};
+	for (std::size_t i = 0; i < n; ++i) {
+		tokens.push_back("--id");
+		tokens.push_back(std::to_string(i));
+	}
+	return tokens;
+}
+
+static void invoke_parse_tokens(Argument_Parser &parser, const std::vector<std::string> &tokens) {
+	std::vector<const char *> args;
+	for (const auto &token : tokens)
+		args.push_back(token.c_str());
+	invoke_parse_args(parser, args);
+}
+
+TEST_CASE("Compact value storage") {
+	Argument_Parser parser{Argument_Parser::Options{}.zero_copy(true)};
+	std::vector<int> bound;
+	parser.add_optional("-i", "--id", Opt_Type::APPEND).compact_storage(true).bind(bound);
+	auto &name = parser.add_optional("--name", Opt_Type::APPEND).compact_storage(true);
+	REQUIRE(name.compact_storage());
+	REQUIRE_THROWS_WITH(parser.add_optional("--single").compact_storage(true), Contains("requires an append-type argument"));
+
+	SECTION("Values are copied") {
+		std::vector<std::string> tokens{"prog", "-i", "4", "--name", "", "--id", "-7", "--name", "second"};
+		invoke_parse_tokens(parser, tokens);
+		for (auto &token : tokens)
+			token.assign(token.size(), '#');
+		REQUIRE(parser.args<int>("id") == std::vector<int>{4, -7});
+		REQUIRE(bound == std::vector<int>{4, -7});
+		REQUIRE(parser.arg_count("name") == 2);
+		REQUIRE(parser.arg_at<std::string>("name", 0).empty());
+		REQUIRE(parser.arg_at<String_View>("name", 1) == "second");
+		REQUIRE(parser.arg_at<String_View>("name", 1).data()[6] == '\0');
+	}
+
+	SECTION("Reparsing") {
+		invoke_parse_args(parser, {"prog", "-i", "1", "-i", "2"});
+		invoke_parse_args(parser, {"prog", "--name", "only"});
+		REQUIRE(!parser.has_arg("id"));
+		REQUIRE(parser.args<std::string>("name") == std::vector<std::string>{"only"});
+	}
+
+	SECTION("Snapshots") {
+		invoke_parse_args(parser, {"prog", "-i", "10", "--name", "x", "-i", "20"});
+		const auto blob = parser.snapshot();
+		parser.reset();
+		parser.load_snapshot(blob.data(), blob.size());
+		REQUIRE(parser.args<int>("id") == std::vector<int>{10, 20});
+		REQUIRE(parser.arg<std::string>("name") == "x");
+	}
+
+	SECTION("Switching storage clears the values") {
+		invoke_parse_args(parser, {"prog", "--name", "x"});
+		name.compact_storage(false);
+		REQUIRE(!name.compact_storage());
+		REQUIRE(!parser.has_arg("name"));
+		invoke_parse_args(parser, {"prog", "--name", "y"});
+		REQUIRE(parser.arg<std::string>("name") == "y");
+	}
+}
+
+TEST_CASE("Memory footprint") {
+	constexpr std::size_t N{1000};
+	Argument_Parser views_parser;
+	views_parser.add_positional("input");
+	views_parser.add_optional("--id", Opt_Type::APPEND);
+	Argument_Parser compact_parser;
+	compact_parser.add_positional("input");
+	compact_parser.add_optional("--id", Opt_Type::APPEND).compact_storage(true);
+
+	auto tokens = id_tokens(N);
+	tokens.push_back("file.txt");
+	invoke_parse_tokens(views_parser, tokens);
+	invoke_parse_tokens(compact_parser, tokens);
+
+	/* Every value takes at least its characters and terminator */
+	std::size_t value_bytes{0};
+	for (std::size_t i = 0; i < N; ++i)
+		value_bytes += std::to_string(i).size() + 1;
+	REQUIRE(views_parser.arg_footprint("input") == 9);
+	REQUIRE(views_parser.arg_footprint("id") >= value_bytes + N * sizeof(String_View));
+	REQUIRE(compact_parser.arg_footprint("id") >= value_bytes + N * 4);
+	REQUIRE(compact_parser.arg_footprint("id") < views_parser.arg_footprint("id"));
+
+	/* Cached conversions are included */
+	const auto before = compact_parser.arg_footprint("id");
+	compact_parser.cache_arg<long>("id");
+	REQUIRE(compact_parser.arg_footprint("id") >= before + N * sizeof(long));
+
+	REQUIRE(views_parser.memory_footprint() >= views_parser.arg_footprint("id") + views_parser.arg_footprint("input"));
+	REQUIRE_THROWS_WITH(views_parser.arg_footprint("bogus"), Contains("no argument by the name 'bogus'"));
+
+	/* Reparsing a shorter command line keeps the storage */
+	const auto peak = compact_parser.memory_footprint();
+	invoke_parse_args(compact_parser, {"prog", "--id", "1", "in.txt"});
+	REQUIRE(compact_parser.memory_footprint() == peak);
+}